@@ -0,0 +1,60 @@
+import * as cl from '@node-3d/opencl';
+
+// Measures `setKernelArg` calls per second for scalar, vector and buffer args.
+// Run it on two builds to compare the argument conversion overhead.
+
+const ITERATIONS = 1_000_000;
+
+const { context } = cl.quickStart(true);
+
+const program = cl.createProgramWithSource(context, `
+	__kernel
+	void bench(
+		__global float *data,
+		uint count,
+		float scale,
+		float4 offset,
+		float16 matrix
+	) {
+		size_t i = get_global_id(0);
+		if (i < count) {
+			data[i] = data[i] * scale + offset.x + matrix.s0;
+		}
+	}
+`);
+cl.buildProgram(program, null, '-cl-kernel-arg-info');
+
+const kernel = cl.createKernel(program, 'bench');
+const buffer = cl.createBuffer(context, cl.MEM_READ_WRITE, 1024 * Float32Array.BYTES_PER_ELEMENT);
+
+const offset = [1, 2, 3, 4];
+const matrix = Array.from({ length: 16 }, (_v, i) => i);
+
+const measure = (name: string, cb: (i: number) => void): void => {
+	// warm up, also resolves the cached signature for introspected args
+	for (let i = 0; i < 1000; i++) {
+		cb(i);
+	}
+
+	const start = process.hrtime.bigint();
+	for (let i = 0; i < ITERATIONS; i++) {
+		cb(i);
+	}
+	const ns = Number(process.hrtime.bigint() - start);
+
+	const perSecond = Math.round(ITERATIONS / (ns * 1e-9));
+	console.log(`${name.padEnd(24)} ${perSecond.toLocaleString()} calls/s`);
+};
+
+measure('uint (typed)', (i) => cl.setKernelArg(kernel, 1, 'uint', i));
+measure('uint (introspected)', (i) => cl.setKernelArg(kernel, 1, null, i));
+measure('float (typed)', (i) => cl.setKernelArg(kernel, 2, 'float', i));
+measure('float4 (typed)', () => cl.setKernelArg(kernel, 3, 'float4', offset));
+measure('float16 (typed)', () => cl.setKernelArg(kernel, 4, 'float16', matrix));
+measure('float* (typed)', () => cl.setKernelArg(kernel, 0, 'float*', buffer));
+measure('float* (introspected)', () => cl.setKernelArg(kernel, 0, null, buffer));
+
+cl.releaseMemObject(buffer);
+cl.releaseKernel(kernel);
+cl.releaseProgram(program);
+cl.releaseContext(context);
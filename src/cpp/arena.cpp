@@ -0,0 +1,240 @@
+#include <algorithm>
+
+#include "arena.hpp"
+
+
+namespace opencl {
+
+IMPLEMENT_ES5_CLASS(Arena);
+
+
+void Arena::init(Napi::Env env, Napi::Object exports) {
+	Napi::Function ctor = wrap(env);
+	JS_ASSIGN_METHOD(alloc);
+	JS_ASSIGN_METHOD(getStats);
+	JS_ASSIGN_GETTER(buffer);
+	JS_ASSIGN_GETTER(alignment);
+	exports.Set("Arena", ctor);
+}
+
+
+// Sub-buffer origins must be aligned to CL_DEVICE_MEM_BASE_ADDR_ALIGN of every device
+static cl_int getContextAlignment(cl_context context, size_t *alignment) {
+	size_t devicesSize = 0;
+	cl_int err = clGetContextInfo(context, CL_CONTEXT_DEVICES, 0, nullptr, &devicesSize);
+	if (err != CL_SUCCESS) {
+		return err;
+	}
+	
+	std::vector<cl_device_id> devices(devicesSize / sizeof(cl_device_id));
+	err = clGetContextInfo(context, CL_CONTEXT_DEVICES, devicesSize, devices.data(), nullptr);
+	if (err != CL_SUCCESS) {
+		return err;
+	}
+	
+	*alignment = 1;
+	for (cl_device_id device : devices) {
+		cl_uint bits = 0;
+		err = clGetDeviceInfo(device, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof(cl_uint), &bits, nullptr);
+		if (err != CL_SUCCESS) {
+			return err;
+		}
+		*alignment = std::max(*alignment, static_cast<size_t>(bits / 8));
+	}
+	
+	return CL_SUCCESS;
+}
+
+
+Arena::Arena(const Napi::CallbackInfo& info) { NAPI_ENV;
+	super(info);
+	
+	_buffer = nullptr;
+	_alignment = 1;
+	_state = std::make_shared<State>();
+	_state->size = 0;
+	_state->used = 0;
+	_state->highWater = 0;
+	_state->allocations = 0;
+	
+	Wrapper *contextWrapper = info[0].IsObject()
+		? Wrapper::unwrap(info[0].As<Napi::Object>())
+		: nullptr;
+	if (!contextWrapper) {
+		JS_THROW("Argument 0 must be a CL Wrapper.");
+		return;
+	}
+	if (!info[1].IsNumber()) {
+		JS_THROW("Argument 1 must be of type `Number`");
+		return;
+	}
+	
+	cl_context context = contextWrapper->as<cl_context>();
+	size_t size = static_cast<size_t>(info[1].ToNumber().DoubleValue());
+	cl_mem_flags flags = info[2].IsNumber()
+		? static_cast<cl_mem_flags>(info[2].ToNumber().DoubleValue())
+		: CL_MEM_READ_WRITE;
+	
+	cl_int err = getContextAlignment(context, &_alignment);
+	if (err != CL_SUCCESS) {
+		JS_THROW(getExceptionMessage(err));
+		return;
+	}
+	
+	size = size - size % _alignment;
+	_buffer = clCreateBuffer(context, flags, size, nullptr, &err);
+	if (err != CL_SUCCESS) {
+		_buffer = nullptr;
+		JS_THROW(getExceptionMessage(err));
+		return;
+	}
+	
+	_state->size = size;
+	_state->free[0] = size;
+}
+
+
+// The live sub-buffers keep the parent buffer alive on their own
+Arena::~Arena() {
+	if (_buffer) {
+		clReleaseMemObject(_buffer);
+	}
+}
+
+
+bool Arena::State::take(size_t bytes, size_t *offset) {
+	std::lock_guard<std::mutex> lock(mutex);
+	
+	// First fit keeps the low offsets busy and the tail free for large regions
+	for (auto it = free.begin(); it != free.end(); it++) {
+		if (it->second < bytes) {
+			continue;
+		}
+		*offset = it->first;
+		size_t rest = it->second - bytes;
+		free.erase(it);
+		if (rest) {
+			free[*offset + bytes] = rest;
+		}
+		
+		used += bytes;
+		highWater = std::max(highWater, used);
+		allocations++;
+		return true;
+	}
+	
+	return false;
+}
+
+
+void Arena::State::give(size_t offset, size_t bytes) {
+	std::lock_guard<std::mutex> lock(mutex);
+	
+	used -= bytes;
+	allocations--;
+	
+	auto next = free.lower_bound(offset);
+	if (next != free.end() && offset + bytes == next->first) {
+		bytes += next->second;
+		next = free.erase(next);
+	}
+	if (next != free.begin()) {
+		auto prev = std::prev(next);
+		if (prev->first + prev->second == offset) {
+			prev->second += bytes;
+			return;
+		}
+	}
+	free[offset] = bytes;
+}
+
+
+void CL_CALLBACK Arena::_regionDestroyed(cl_mem, void *ptr) {
+	Region *region = reinterpret_cast<Region*>(ptr);
+	region->state->give(region->offset, region->size);
+	delete region;
+}
+
+
+JS_IMPLEMENT_METHOD(Arena, alloc) { NAPI_ENV;
+	REQ_OFFS_ARG(0, size);
+	LET_OFFS_ARG(1, flags);
+	
+	if (!_buffer) {
+		THROW_ERR(CL_INVALID_MEM_OBJECT);
+	}
+	if (!size) {
+		THROW_ERR(CL_INVALID_BUFFER_SIZE);
+	}
+	
+	size_t bytes = (size + _alignment - 1) / _alignment * _alignment;
+	size_t offset = 0;
+	if (!_state->take(bytes, &offset)) {
+		THROW_ERR(CL_MEM_OBJECT_ALLOCATION_FAILURE);
+	}
+	
+	cl_buffer_region bufferRegion = { offset, size };
+	cl_int err = CL_SUCCESS;
+	cl_mem mem = clCreateSubBuffer(
+		_buffer, flags, CL_BUFFER_CREATE_TYPE_REGION, &bufferRegion, &err
+	);
+	if (err != CL_SUCCESS) {
+		_state->give(offset, bytes);
+		THROW_ERR(err);
+	}
+	
+	Region *region = new Region { _state, offset, bytes };
+	err = clSetMemObjectDestructorCallback(mem, _regionDestroyed, region);
+	if (err != CL_SUCCESS) {
+		delete region;
+		clReleaseMemObject(mem);
+		_state->give(offset, bytes);
+		THROW_ERR(err);
+	}
+	
+	RET_WRAPPER(mem);
+}
+
+
+JS_IMPLEMENT_METHOD(Arena, getStats) { NAPI_ENV;
+	std::lock_guard<std::mutex> lock(_state->mutex);
+	
+	size_t freeBytes = 0;
+	size_t largestFree = 0;
+	for (const auto &it : _state->free) {
+		freeBytes += it.second;
+		largestFree = std::max(largestFree, it.second);
+	}
+	
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("size", JS_NUM(_state->size));
+	result.Set("used", JS_NUM(_state->used));
+	result.Set("free", JS_NUM(freeBytes));
+	result.Set("highWater", JS_NUM(_state->highWater));
+	result.Set("allocations", JS_NUM(_state->allocations));
+	result.Set("freeRegions", JS_NUM(_state->free.size()));
+	result.Set("largestFree", JS_NUM(largestFree));
+	// 0 when all the free memory is one region, close to 1 when it is scattered
+	result.Set(
+		"fragmentation",
+		JS_NUM(freeBytes ? 1.0 - static_cast<double>(largestFree) / freeBytes : 0.0)
+	);
+	
+	RET_VALUE(result);
+}
+
+
+JS_IMPLEMENT_GETTER(Arena, buffer) { NAPI_ENV;
+	if (!_buffer) {
+		RET_NULL;
+	}
+	// Borrowed, the arena keeps the reference
+	RET_VALUE(Wrapper::fromBorrowed(env, _buffer));
+}
+
+
+JS_IMPLEMENT_GETTER(Arena, alignment) { NAPI_ENV;
+	RET_NUM(_alignment);
+}
+
+} // namespace opencl
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "wrapper.hpp"
+
+
+namespace opencl {
+
+// Sub-allocates regions of one large buffer as sub-buffers. A region goes
+// back to the free list when its sub-buffer is destroyed by OpenCL.
+class Arena {
+DECLARE_ES5_CLASS(Arena, Arena);
+
+public:
+	static void init(Napi::Env env, Napi::Object exports);
+	
+	explicit Arena(const Napi::CallbackInfo& info);
+	~Arena();
+	
+	JS_DECLARE_METHOD(Arena, alloc);
+	JS_DECLARE_METHOD(Arena, getStats);
+	JS_DECLARE_GETTER(Arena, buffer);
+	JS_DECLARE_GETTER(Arena, alignment);
+
+private:
+	// Shared with the destructor callbacks, that may outlive the Arena
+	struct State {
+		std::mutex mutex;
+		// Free regions as offset -> size, adjacent regions are merged
+		std::map<size_t, size_t> free;
+		size_t size;
+		size_t used;
+		size_t highWater;
+		size_t allocations;
+		
+		bool take(size_t size, size_t *offset);
+		void give(size_t offset, size_t size);
+	};
+	
+	struct Region {
+		std::shared_ptr<State> state;
+		size_t offset;
+		size_t size;
+	};
+	
+	cl_mem _buffer;
+	size_t _alignment;
+	std::shared_ptr<State> _state;
+	
+	static void CL_CALLBACK _regionDestroyed(cl_mem mem, void *ptr);
+};
+
+} // namespace opencl
@@ -1,14 +1,20 @@
 #include "./wrapper.cpp"
 #include "./queue.cpp"
+#include "./arena.cpp"
+#include "./command-list.cpp"
 #include "./common.cpp"
 #include "./context.cpp"
 #include "./device.cpp"
 #include "./event.cpp"
+#include "./file-buffer.cpp"
 #include "./kernel.cpp"
+#include "./mapping.cpp"
 #include "./memobj.cpp"
 #include "./platform.cpp"
 #include "./program.cpp"
 #include "./sampler.cpp"
+#include "./staging.cpp"
+#include "./svm.cpp"
 
 
 #define JS_CL_CONSTANT(name)                                                  \
@@ -39,22 +45,47 @@
 
 Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	opencl::Wrapper::init(env, exports);
+	opencl::Arena::init(env, exports);
+	opencl::CommandList::init(env, exports);
+	opencl::Mapping::init(env, exports);
+	
+	JS_CL_SET_METHOD(setAutoRelease);
+	JS_CL_SET_METHOD(getLiveObjectCounts);
+	JS_CL_SET_METHOD(setObjectTracking);
+	JS_CL_SET_METHOD(getObjectStats);
+	JS_CL_SET_METHOD(getLiveObjects);
 	
 	JS_CL_SET_METHOD(createKernel);
+	JS_CL_SET_METHOD(cloneKernel);
 	JS_CL_SET_METHOD(createKernelsInProgram);
 	JS_CL_SET_METHOD(retainKernel);
 	JS_CL_SET_METHOD(releaseKernel);
 	JS_CL_SET_METHOD(setKernelArg);
+	JS_CL_SET_METHOD(setKernelArgs);
+	JS_CL_SET_METHOD(setKernelArgTypes);
 	JS_CL_SET_METHOD(getKernelInfo);
 	JS_CL_SET_METHOD(getKernelArgInfo);
 	JS_CL_SET_METHOD(getKernelWorkGroupInfo);
 	
 	JS_CL_SET_METHOD(createBuffer);
+	JS_CL_SET_METHOD(createBufferFromFile);
 	JS_CL_SET_METHOD(createSubBuffer);
 	JS_CL_SET_METHOD(createImage);
 	JS_CL_SET_METHOD(retainMemObject);
 	JS_CL_SET_METHOD(releaseMemObject);
+	JS_CL_SET_METHOD(createPooledBuffer);
+	JS_CL_SET_METHOD(releasePooledBuffer);
+	JS_CL_SET_METHOD(trimBufferPool);
+	JS_CL_SET_METHOD(setBufferPoolLimit);
+	JS_CL_SET_METHOD(getBufferPoolStats);
 	JS_CL_SET_METHOD(getSupportedImageFormats);
+	JS_CL_SET_METHOD(acquireStagingBuffer);
+	JS_CL_SET_METHOD(releaseStagingBuffer);
+	JS_CL_SET_METHOD(trimStagingBuffers);
+	JS_CL_SET_METHOD(svmAlloc);
+	JS_CL_SET_METHOD(svmFree);
+	JS_CL_SET_METHOD(setKernelArgSVMPointer);
+	JS_CL_SET_METHOD(setKernelExecInfo);
 	JS_CL_SET_METHOD(getMemObjectInfo);
 	JS_CL_SET_METHOD(getImageInfo);
 	JS_CL_SET_METHOD(createFromGLBuffer);
@@ -67,10 +98,12 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_SET_METHOD2(createProgram, createProgramWithSource);
 	JS_CL_SET_METHOD(createProgramWithSource);
 	JS_CL_SET_METHOD(createProgramWithBinary);
+	JS_CL_SET_METHOD(createProgramWithIL);
 	JS_CL_SET_METHOD(createProgramWithBuiltInKernels);
 	JS_CL_SET_METHOD(retainProgram);
 	JS_CL_SET_METHOD(releaseProgram);
 	JS_CL_SET_METHOD(buildProgram);
+	JS_CL_SET_METHOD(buildProgramAsync);
 	JS_CL_SET_METHOD(compileProgram);
 	JS_CL_SET_METHOD(linkProgram);
 	JS_CL_SET_METHOD(unloadPlatformCompiler);
@@ -88,21 +121,29 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_SET_METHOD(getCommandQueueInfo);
 	JS_CL_SET_METHOD(flush);
 	JS_CL_SET_METHOD(finish);
+	JS_CL_SET_METHOD(finishAsync);
 	JS_CL_SET_METHOD(enqueueReadBuffer);
+	JS_CL_SET_METHOD(enqueueReadBufferAsync);
 	JS_CL_SET_METHOD(enqueueReadBufferRect);
 	JS_CL_SET_METHOD(enqueueWriteBuffer);
+	JS_CL_SET_METHOD(enqueueWriteBufferAsync);
 	JS_CL_SET_METHOD(enqueueWriteBufferRect);
 	JS_CL_SET_METHOD(enqueueCopyBuffer);
 	JS_CL_SET_METHOD(enqueueCopyBufferRect);
 	JS_CL_SET_METHOD(enqueueReadImage);
+	JS_CL_SET_METHOD(enqueueReadImageAsync);
 	JS_CL_SET_METHOD(enqueueWriteImage);
+	JS_CL_SET_METHOD(enqueueWriteImageAsync);
 	JS_CL_SET_METHOD(enqueueCopyImage);
 	JS_CL_SET_METHOD(enqueueCopyImageToBuffer);
 	JS_CL_SET_METHOD(enqueueCopyBufferToImage);
 	JS_CL_SET_METHOD(enqueueMapBuffer);
+	JS_CL_SET_METHOD(enqueueMapBufferAsync);
 	JS_CL_SET_METHOD(enqueueMapImage);
+	JS_CL_SET_METHOD(enqueueMapImageAsync);
 	JS_CL_SET_METHOD(enqueueUnmapMemObject);
 	JS_CL_SET_METHOD(enqueueNDRangeKernel);
+	JS_CL_SET_METHOD(dispatch);
 	JS_CL_SET_METHOD(enqueueTask);
 	JS_CL_SET_METHOD(enqueueNativeKernel);
 	JS_CL_SET_METHOD(enqueueMarker);
@@ -114,6 +155,10 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_SET_METHOD(enqueueMigrateMemObjects);
 	JS_CL_SET_METHOD(enqueueAcquireGLObjects);
 	JS_CL_SET_METHOD(enqueueReleaseGLObjects);
+	JS_CL_SET_METHOD(enqueueSVMMap);
+	JS_CL_SET_METHOD(enqueueSVMUnmap);
+	JS_CL_SET_METHOD(enqueueSVMMemcpy);
+	JS_CL_SET_METHOD(enqueueSVMMemFill);
 	
 	JS_CL_SET_METHOD(createContext);
 	JS_CL_SET_METHOD(createContextFromType);
@@ -128,6 +173,10 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_SET_METHOD(releaseDevice);
 	
 	JS_CL_SET_METHOD(waitForEvents);
+	JS_CL_SET_METHOD(waitForEventsAsync);
+	JS_CL_SET_METHOD(releaseEventHandle);
+	JS_CL_SET_METHOD(eventFromHandle);
+	JS_CL_SET_METHOD(getEventHandleCount);
 	JS_CL_SET_METHOD(getEventInfo);
 	JS_CL_SET_METHOD(createUserEvent);
 	JS_CL_SET_METHOD(retainEvent);
@@ -145,6 +194,9 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CONSTANT(size_DOUBLE, sizeof(double));
 	JS_CONSTANT(size_HALF, sizeof(float) >> 1);
 	
+	// `hasEvent` value to get a numeric event handle
+	JS_CONSTANT(EVENT_HANDLE, EVENT_HANDLE_FLAG);
+	
 	// Error Codes as exceptions
 	JS_CL_ERROR(DEVICE_NOT_FOUND);
 	JS_CL_ERROR(DEVICE_NOT_AVAILABLE);
@@ -311,6 +363,8 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_CONSTANT(DEVICE_REFERENCE_COUNT);
 	JS_CL_CONSTANT(DEVICE_PREFERRED_INTEROP_USER_SYNC);
 	JS_CL_CONSTANT(DEVICE_PRINTF_BUFFER_SIZE);
+	JS_CL_CONSTANT(DEVICE_SVM_CAPABILITIES);
+	JS_CL_CONSTANT(DEVICE_IL_VERSION);
 	
 	// cl_device_fp_config - bitfield
 	JS_CL_CONSTANT(FP_DENORM);
@@ -335,6 +389,12 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_CONSTANT(EXEC_KERNEL);
 	JS_CL_CONSTANT(EXEC_NATIVE_KERNEL);
 	
+	// cl_device_svm_capabilities - bitfield
+	JS_CL_CONSTANT(DEVICE_SVM_COARSE_GRAIN_BUFFER);
+	JS_CL_CONSTANT(DEVICE_SVM_FINE_GRAIN_BUFFER);
+	JS_CL_CONSTANT(DEVICE_SVM_FINE_GRAIN_SYSTEM);
+	JS_CL_CONSTANT(DEVICE_SVM_ATOMICS);
+	
 	// cl_command_queue_properties - bitfield
 	JS_CL_CONSTANT(QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE);
 	JS_CL_CONSTANT(QUEUE_PROFILING_ENABLE);
@@ -379,6 +439,8 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_CONSTANT(MEM_HOST_WRITE_ONLY);
 	JS_CL_CONSTANT(MEM_HOST_READ_ONLY);
 	JS_CL_CONSTANT(MEM_HOST_NO_ACCESS);
+	JS_CL_CONSTANT(MEM_SVM_FINE_GRAIN_BUFFER);
+	JS_CL_CONSTANT(MEM_SVM_ATOMICS);
 	
 	// cl_mem_migration_flags - bitfield
 	JS_CL_CONSTANT(MIGRATE_MEM_OBJECT_HOST);
@@ -484,6 +546,7 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_CONSTANT(PROGRAM_BINARIES);
 	JS_CL_CONSTANT(PROGRAM_NUM_KERNELS);
 	JS_CL_CONSTANT(PROGRAM_KERNEL_NAMES);
+	JS_CL_CONSTANT(PROGRAM_IL);
 	
 	// cl_program_build_info
 	JS_CL_CONSTANT(PROGRAM_BUILD_STATUS);
@@ -511,6 +574,10 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 	JS_CL_CONSTANT(KERNEL_PROGRAM);
 	JS_CL_CONSTANT(KERNEL_ATTRIBUTES);
 	
+	// cl_kernel_exec_info
+	JS_CL_CONSTANT(KERNEL_EXEC_INFO_SVM_PTRS);
+	JS_CL_CONSTANT(KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM);
+	
 	// cl_kernel_arg_info
 	JS_CL_CONSTANT(KERNEL_ARG_ADDRESS_QUALIFIER);
 	JS_CL_CONSTANT(KERNEL_ARG_ACCESS_QUALIFIER);
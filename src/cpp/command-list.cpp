@@ -0,0 +1,554 @@
+#include "command-list.hpp"
+#include "keep-alive-helper.hpp"
+
+
+namespace opencl {
+
+// Recorded kernel arg payloads are kept aligned within the shared storage
+#define ARG_DATA_ALIGN 16
+
+// Restores the recorder state of MARK and throws, if ERR is not CL_SUCCESS
+#define CHECK_RECORD_ERR(MARK, ERR)                                           \
+	{                                                                         \
+		cl_int _recordErr = (ERR);                                            \
+		if (_recordErr != CL_SUCCESS) {                                       \
+			_rollback(env, MARK);                                             \
+			THROW_ERR(_recordErr);                                            \
+		}                                                                     \
+	}
+
+
+IMPLEMENT_ES5_CLASS(CommandList);
+
+
+void CommandList::init(Napi::Env env, Napi::Object exports) {
+	Napi::Function ctor = wrap(env);
+	JS_ASSIGN_METHOD(write);
+	JS_ASSIGN_METHOD(read);
+	JS_ASSIGN_METHOD(copy);
+	JS_ASSIGN_METHOD(ndrange);
+	JS_ASSIGN_METHOD(barrier);
+	JS_ASSIGN_METHOD(run);
+	JS_ASSIGN_METHOD(clear);
+	JS_ASSIGN_GETTER(length);
+	exports.Set("CommandList", ctor);
+}
+
+
+CommandList::CommandList(const Napi::CallbackInfo& info) { NAPI_ENV;
+	super(info);
+	_reset(env);
+}
+
+
+// The runs in flight keep their own references to `_retained` and `_hosts`
+CommandList::~CommandList() {
+}
+
+
+CommandList::Retained::~Retained() {
+	for (cl_mem mem : mems) {
+		clReleaseMemObject(mem);
+	}
+	for (cl_kernel kernel : kernels) {
+		clReleaseKernel(kernel);
+	}
+	for (cl_sampler sampler : samplers) {
+		clReleaseSampler(sampler);
+	}
+}
+
+
+void CommandList::_reset(Napi::Env env) {
+	_commands.clear();
+	_args.clear();
+	_argData.clear();
+	_deps.clear();
+	_retained = std::make_shared<Retained>();
+	_hosts.Reset(Napi::Array::New(env), 1);
+}
+
+
+void CommandList::_retainedFinalized(Napi::Env, std::shared_ptr<Retained> *retained) {
+	delete retained;
+}
+
+
+// The objects and host arrays of this run stay referenced until `event`
+// completes. If that can't be tracked, the run is waited for right away
+void CommandList::_keepUntilComplete(Napi::Env env, cl_event event) {
+	Napi::Object keep = Napi::Object::New(env);
+	keep.Set("hosts", _hosts.Value());
+	keep.Set("retained", Napi::External<std::shared_ptr<Retained>>::New(
+		env, new std::shared_ptr<Retained>(_retained), _retainedFinalized
+	));
+	
+	if (KeepAliveHelper::untilComplete(env, event, keep) != CL_SUCCESS) {
+		clWaitForEvents(1, &event);
+	}
+}
+
+
+CommandList::Mark CommandList::_mark() {
+	return {
+		_deps.size(),
+		_argData.size(),
+		_retained->mems.size(),
+		_retained->kernels.size(),
+		_retained->samplers.size(),
+		_hosts.Value().As<Napi::Array>().Length(),
+	};
+}
+
+
+// Releases what the failed command has retained so far
+void CommandList::_rollback(Napi::Env env, const Mark &mark) {
+	_deps.resize(mark.deps);
+	_argData.resize(mark.argData);
+	
+	Retained &retained = *_retained;
+	for (size_t i = mark.mems; i < retained.mems.size(); i++) {
+		clReleaseMemObject(retained.mems[i]);
+	}
+	retained.mems.resize(mark.mems);
+	for (size_t i = mark.kernels; i < retained.kernels.size(); i++) {
+		clReleaseKernel(retained.kernels[i]);
+	}
+	retained.kernels.resize(mark.kernels);
+	for (size_t i = mark.samplers; i < retained.samplers.size(); i++) {
+		clReleaseSampler(retained.samplers[i]);
+	}
+	retained.samplers.resize(mark.samplers);
+	
+	_hosts.Value().Set("length", JS_NUM(mark.hosts));
+}
+
+
+// The dependencies only produce events once the command is recorded
+uint32_t CommandList::_commit(const Command &command) {
+	for (size_t i = command.depsBegin; i < command.depsEnd; i++) {
+		_commands[_deps[i]].hasEvent = true;
+	}
+	_commands.push_back(command);
+	return static_cast<uint32_t>(_commands.size() - 1);
+}
+
+
+bool CommandList::_readDeps(Napi::Env env, Napi::Value deps, Command *command) {
+	command->depsBegin = _deps.size();
+	command->depsEnd = _deps.size();
+	
+	if (IS_EMPTY(deps)) {
+		return true;
+	}
+	if (!deps.IsArray()) {
+		JS_THROW("Dependencies must be an Array of command indices.");
+		return false;
+	}
+	
+	Napi::Array arr = deps.As<Napi::Array>();
+	for (uint32_t i = 0; i < arr.Length(); i++) {
+		Napi::Value item = arr.Get(i);
+		uint32_t dep = item.IsNumber() ? item.ToNumber().Uint32Value() : UINT32_MAX;
+		if (dep >= _commands.size()) {
+			_deps.resize(command->depsBegin);
+			Wrapper::throwArrayEx(env, i, "is not a recorded command index.");
+			return false;
+		}
+		_deps.push_back(dep);
+	}
+	
+	command->depsEnd = _deps.size();
+	return true;
+}
+
+
+bool CommandList::_readHost(Napi::Env env, Napi::Value host, size_t size, Command *command) {
+	void *ptr = nullptr;
+	size_t len = 0;
+	if (host.IsObject()) {
+		getPtrAndLen(host.As<Napi::Object>(), &ptr, &len);
+	}
+	
+	if (!ptr || !len) {
+		JS_THROW("Could not read buffer data.");
+		return false;
+	}
+	if (len < size) {
+		JS_THROW("Host data is smaller than the requested size.");
+		return false;
+	}
+	
+	Napi::Array hosts = _hosts.Value().As<Napi::Array>();
+	command->host = hosts.Length();
+	hosts.Set(command->host, host);
+	
+	return true;
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, write) { NAPI_ENV;
+	REQ_CL_ARG(0, mem, cl_mem);
+	REQ_OFFS_ARG(1, offset);
+	REQ_OFFS_ARG(2, size);
+	REQ_OBJ_ARG(3, host);
+	
+	Command command = {};
+	command.type = Command::Write;
+	command.dst = mem;
+	command.dstOffset = offset;
+	command.size = size;
+	
+	Mark mark = _mark();
+	if (!_readDeps(env, info[4], &command)) {
+		RET_UNDEFINED;
+	}
+	if (!_readHost(env, host, size, &command)) {
+		_rollback(env, mark);
+		RET_UNDEFINED;
+	}
+	
+	CHECK_RECORD_ERR(mark, clRetainMemObject(mem));
+	_retained->mems.push_back(mem);
+	
+	RET_NUM(_commit(command));
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, read) { NAPI_ENV;
+	REQ_CL_ARG(0, mem, cl_mem);
+	REQ_OFFS_ARG(1, offset);
+	REQ_OFFS_ARG(2, size);
+	REQ_OBJ_ARG(3, host);
+	
+	Command command = {};
+	command.type = Command::Read;
+	command.src = mem;
+	command.srcOffset = offset;
+	command.size = size;
+	
+	Mark mark = _mark();
+	if (!_readDeps(env, info[4], &command)) {
+		RET_UNDEFINED;
+	}
+	if (!_readHost(env, host, size, &command)) {
+		_rollback(env, mark);
+		RET_UNDEFINED;
+	}
+	
+	CHECK_RECORD_ERR(mark, clRetainMemObject(mem));
+	_retained->mems.push_back(mem);
+	
+	RET_NUM(_commit(command));
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, copy) { NAPI_ENV;
+	REQ_CL_ARG(0, src, cl_mem);
+	REQ_CL_ARG(1, dst, cl_mem);
+	REQ_OFFS_ARG(2, srcOffset);
+	REQ_OFFS_ARG(3, dstOffset);
+	REQ_OFFS_ARG(4, size);
+	
+	Command command = {};
+	command.type = Command::Copy;
+	command.src = src;
+	command.dst = dst;
+	command.srcOffset = srcOffset;
+	command.dstOffset = dstOffset;
+	command.size = size;
+	
+	Mark mark = _mark();
+	if (!_readDeps(env, info[5], &command)) {
+		RET_UNDEFINED;
+	}
+	
+	CHECK_RECORD_ERR(mark, clRetainMemObject(src));
+	_retained->mems.push_back(src);
+	CHECK_RECORD_ERR(mark, clRetainMemObject(dst));
+	_retained->mems.push_back(dst);
+	
+	RET_NUM(_commit(command));
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, ndrange) { NAPI_ENV;
+	REQ_WRAP_ARG(0, kernelWrapper);
+	cl_kernel kernel = kernelWrapper->as<cl_kernel>();
+	
+	Command command = {};
+	command.type = Command::NDRange;
+	command.kernel = kernel;
+	command.global[0] = command.global[1] = command.global[2] = 1;
+	command.local[0] = command.local[1] = command.local[2] = 1;
+	
+	command.workDim = readWorkSizes(info[2], command.global);
+	if (!command.workDim) {
+		THROW_ERR(CL_INVALID_GLOBAL_WORK_SIZE);
+	}
+	
+	command.hasLocal = !IS_ARG_EMPTY(3);
+	if (command.hasLocal && readWorkSizes(info[3], command.local) != command.workDim) {
+		THROW_ERR(CL_INVALID_WORK_GROUP_SIZE);
+	}
+	
+	// Arguments are converted now, and only copied to the kernel on `run()`
+	std::vector<RecordedArg> args;
+	std::vector<void*> handles;
+	std::vector<KernelArg::Kind> handleKinds;
+	Mark mark = _mark();
+	
+	if (!IS_ARG_EMPTY(1)) {
+		REQ_ARRAY_ARG(1, values);
+		
+		for (uint32_t i = 0; i < values.Length(); i++) {
+			std::string type_name;
+			KernelArg arg = { KernelArg::Unknown, nullptr };
+			cl_int err = resolveKernelArg(kernelWrapper, i, &arg, &type_name);
+			
+			if (err == CL_SUCCESS && arg.kind == KernelArg::Unknown) {
+				_rollback(env, mark);
+				std::string errstr = std::string("has unsupported OpenCL argument type: ") + type_name;
+				Wrapper::throwArrayEx(env, i, errstr.c_str());
+				RET_UNDEFINED;
+			}
+			
+			alignas(16) uint8_t data[KERNEL_ARG_SCRATCH_SIZE];
+			const char *msg = nullptr;
+			RecordedArg recorded = { i, arg.kind == KernelArg::Local, 0, _argData.size() };
+			if (err == CL_SUCCESS) {
+				err = encodeKernelArg(arg, values.Get(i), data, &recorded.size, &msg);
+			}
+			if (msg) {
+				_rollback(env, mark);
+				Wrapper::throwArrayEx(env, i, msg);
+				RET_UNDEFINED;
+			}
+			if (err != CL_SUCCESS) {
+				_rollback(env, mark);
+				std::string errstr = std::string("failed: ") + getExceptionMessage(err);
+				Wrapper::throwArrayEx(env, i, errstr.c_str());
+				RET_UNDEFINED;
+			}
+			
+			if (!recorded.isLocal) {
+				size_t padded = (recorded.size + ARG_DATA_ALIGN - 1) & ~(ARG_DATA_ALIGN - 1);
+				_argData.insert(_argData.end(), data, data + recorded.size);
+				_argData.resize(recorded.offset + padded, 0);
+			}
+			if (arg.kind == KernelArg::Mem || arg.kind == KernelArg::Sampler) {
+				handles.push_back(*reinterpret_cast<void**>(data));
+				handleKinds.push_back(arg.kind);
+			}
+			
+			args.push_back(recorded);
+		}
+	}
+	
+	if (!_readDeps(env, info[4], &command)) {
+		_rollback(env, mark);
+		RET_UNDEFINED;
+	}
+	
+	CHECK_RECORD_ERR(mark, clRetainKernel(kernel));
+	_retained->kernels.push_back(kernel);
+	
+	for (size_t i = 0; i < handles.size(); i++) {
+		if (handleKinds[i] == KernelArg::Mem) {
+			cl_mem mem = reinterpret_cast<cl_mem>(handles[i]);
+			CHECK_RECORD_ERR(mark, clRetainMemObject(mem));
+			_retained->mems.push_back(mem);
+		} else {
+			cl_sampler sampler = reinterpret_cast<cl_sampler>(handles[i]);
+			CHECK_RECORD_ERR(mark, clRetainSampler(sampler));
+			_retained->samplers.push_back(sampler);
+		}
+	}
+	
+	command.argsBegin = _args.size();
+	_args.insert(_args.end(), args.begin(), args.end());
+	command.argsEnd = _args.size();
+	
+	// The SVM memory set on the kernel (e.g. its exec info) is kept like a host array
+	Napi::Value svmRefs = kernelWrapper->copySvmRefs(env);
+	if (!svmRefs.IsUndefined()) {
+		Napi::Array hosts = _hosts.Value().As<Napi::Array>();
+		hosts.Set(hosts.Length(), svmRefs);
+	}
+	
+	RET_NUM(_commit(command));
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, barrier) { NAPI_ENV;
+	Command command = {};
+	command.type = Command::Barrier;
+	
+	if (!_readDeps(env, info[0], &command)) {
+		RET_UNDEFINED;
+	}
+	
+	RET_NUM(_commit(command));
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, run) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	GET_WAIT_LIST(1);
+	SOFT_BOOL_ARG(2, hasEvent);
+	bool isEventHandle = IS_EVENT_HANDLE_FLAG(2);
+	
+	Napi::Array hosts = _hosts.Value().As<Napi::Array>();
+	
+	// The host arrays are checked before anything is enqueued
+	std::vector<void*> hostPtrs(_commands.size(), nullptr);
+	for (size_t i = 0; i < _commands.size(); i++) {
+		const Command &command = _commands[i];
+		if (command.type != Command::Write && command.type != Command::Read) {
+			continue;
+		}
+		size_t len = 0;
+		Napi::Value host = hosts.Get(command.host);
+		getPtrAndLen(host.As<Napi::Object>(), &hostPtrs[i], &len);
+		if (!hostPtrs[i] || len < command.size) {
+			THROW_ERR(CL_INVALID_HOST_PTR);
+		}
+	}
+	
+	// Internal events, only for the commands that others depend on
+	std::vector<cl_event> events(_commands.size(), nullptr);
+	std::vector<cl_event> waits;
+	cl_int err = CL_SUCCESS;
+	size_t enqueued = 0;
+	
+	for (size_t i = 0; i < _commands.size() && err == CL_SUCCESS; i++) {
+		const Command &command = _commands[i];
+		
+		// The external wait list applies to the commands without dependencies
+		waits.clear();
+		if (command.depsBegin == command.depsEnd) {
+			waits = cl_events;
+		} else {
+			for (size_t d = command.depsBegin; d < command.depsEnd; d++) {
+				waits.push_back(events[_deps[d]]);
+			}
+		}
+		cl_uint numWaits = static_cast<cl_uint>(waits.size());
+		const cl_event *waitList = waits.empty() ? nullptr : waits.data();
+		cl_event *eventPtr = command.hasEvent ? &events[i] : nullptr;
+		
+		switch (command.type) {
+			case Command::Write:
+			case Command::Read: {
+				void *ptr = hostPtrs[i];
+				if (command.type == Command::Write) {
+					err = clEnqueueWriteBuffer(
+						clQueue, command.dst, CL_FALSE, command.dstOffset, command.size,
+						ptr, numWaits, waitList, eventPtr
+					);
+				} else {
+					err = clEnqueueReadBuffer(
+						clQueue, command.src, CL_FALSE, command.srcOffset, command.size,
+						ptr, numWaits, waitList, eventPtr
+					);
+				}
+				break;
+			}
+			case Command::Copy: {
+				err = clEnqueueCopyBuffer(
+					clQueue, command.src, command.dst, command.srcOffset,
+					command.dstOffset, command.size, numWaits, waitList, eventPtr
+				);
+				break;
+			}
+			case Command::NDRange: {
+				for (size_t a = command.argsBegin; a < command.argsEnd && err == CL_SUCCESS; a++) {
+					const RecordedArg &arg = _args[a];
+					err = clSetKernelArg(
+						command.kernel,
+						arg.index,
+						arg.size,
+						arg.isLocal ? nullptr : &_argData[arg.offset]
+					);
+				}
+				if (err != CL_SUCCESS) {
+					break;
+				}
+				err = clEnqueueNDRangeKernel(
+					clQueue,
+					command.kernel,
+					command.workDim,
+					nullptr,
+					command.global,
+					command.hasLocal ? command.local : nullptr,
+					numWaits,
+					waitList,
+					eventPtr
+				);
+				break;
+			}
+			case Command::Barrier: {
+				err = clEnqueueBarrierWithWaitList(clQueue, numWaits, waitList, eventPtr);
+				break;
+			}
+		}
+		
+		if (err == CL_SUCCESS) {
+			enqueued++;
+		}
+	}
+	
+	for (cl_event internal : events) {
+		if (internal) {
+			clReleaseEvent(internal);
+		}
+	}
+	
+	// A marker without a wait list completes after all of the commands above.
+	// Even a failed run keeps its objects until the enqueued commands are done
+	cl_event event = nullptr;
+	if (enqueued) {
+		cl_int markerErr = clEnqueueMarkerWithWaitList(clQueue, 0, nullptr, &event);
+		if (markerErr != CL_SUCCESS) {
+			clFinish(clQueue);
+			CHECK_ERR(err);
+			THROW_ERR(markerErr);
+		}
+		_keepUntilComplete(env, event);
+	}
+	
+	if (err != CL_SUCCESS) {
+		if (event) {
+			clReleaseEvent(event);
+		}
+		THROW_ERR(err);
+	}
+	
+	if (hasEvent) {
+		// An empty list completes right away
+		if (!event) {
+			CHECK_ERR(clEnqueueMarkerWithWaitList(clQueue, 0, nullptr, &event));
+		}
+		if (isEventHandle) {
+			RET_EVENT_HANDLE(event);
+		}
+		RET_WRAPPER(event);
+	}
+	if (event) {
+		clReleaseEvent(event);
+	}
+	RET_UNDEFINED;
+}
+
+
+JS_IMPLEMENT_METHOD(CommandList, clear) { NAPI_ENV;
+	_reset(env);
+	RET_UNDEFINED;
+}
+
+
+JS_IMPLEMENT_GETTER(CommandList, length) { NAPI_ENV;
+	RET_NUM(_commands.size());
+}
+
+} // namespace opencl
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <memory>
+
+#include "wrapper.hpp"
+
+
+namespace opencl {
+
+// A recorded sequence of commands, replayed by a single `run()` call.
+// Intermediate events stay native, only the dependencies get an event.
+class CommandList {
+DECLARE_ES5_CLASS(CommandList, CommandList);
+
+public:
+	static void init(Napi::Env env, Napi::Object exports);
+	
+	explicit CommandList(const Napi::CallbackInfo& info);
+	~CommandList();
+	
+	JS_DECLARE_METHOD(CommandList, write);
+	JS_DECLARE_METHOD(CommandList, read);
+	JS_DECLARE_METHOD(CommandList, copy);
+	JS_DECLARE_METHOD(CommandList, ndrange);
+	JS_DECLARE_METHOD(CommandList, barrier);
+	JS_DECLARE_METHOD(CommandList, run);
+	JS_DECLARE_METHOD(CommandList, clear);
+	JS_DECLARE_GETTER(CommandList, length);
+
+private:
+	struct Command {
+		enum Type : uint8_t { Write, Read, Copy, NDRange, Barrier };
+		Type type;
+		bool hasEvent;
+		bool hasLocal;
+		cl_uint workDim;
+		cl_mem src;
+		cl_mem dst;
+		cl_kernel kernel;
+		size_t srcOffset;
+		size_t dstOffset;
+		size_t size;
+		uint32_t host;
+		size_t global[3];
+		size_t local[3];
+		size_t argsBegin;
+		size_t argsEnd;
+		size_t depsBegin;
+		size_t depsEnd;
+	};
+	
+	struct RecordedArg {
+		cl_uint index;
+		bool isLocal;
+		size_t size;
+		size_t offset;
+	};
+	
+	std::vector<Command> _commands;
+	std::vector<RecordedArg> _args;
+	std::vector<uint8_t> _argData;
+	std::vector<uint32_t> _deps;
+	
+	// The CL objects used by the commands. Shared with the runs in flight,
+	// so `clear()` doesn't release them under the running commands
+	struct Retained {
+		std::vector<cl_mem> mems;
+		std::vector<cl_kernel> kernels;
+		std::vector<cl_sampler> samplers;
+		~Retained();
+	};
+	std::shared_ptr<Retained> _retained;
+	// Host arrays of read/write commands and the SVM memory of kernels,
+	// referenced until `clear()`,
+	// and by the runs in flight
+	Napi::ObjectReference _hosts;
+	
+	// The recorder state before a command, restored if recording fails
+	struct Mark {
+		size_t deps;
+		size_t argData;
+		size_t mems;
+		size_t kernels;
+		size_t samplers;
+		uint32_t hosts;
+	};
+	
+	Mark _mark();
+	void _rollback(Napi::Env env, const Mark &mark);
+	uint32_t _commit(const Command &command);
+	bool _readDeps(Napi::Env env, Napi::Value deps, Command *command);
+	bool _readHost(Napi::Env env, Napi::Value host, size_t size, Command *command);
+	void _reset(Napi::Env env);
+	void _keepUntilComplete(Napi::Env env, cl_event event);
+	
+	static void _retainedFinalized(Napi::Env env, std::shared_ptr<Retained> *retained);
+};
+
+} // namespace opencl
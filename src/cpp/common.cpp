@@ -1,3 +1,9 @@
+#include "win32.hpp"
+
+#ifndef _WIN32
+	#include <dlfcn.h>
+#endif
+
 #include "common.hpp"
 
 
@@ -16,6 +22,15 @@ void getPtrAndLen(Napi::Object obj, void** ptr, size_t *len) {
 	}
 }
 
+void* getClFunction(const char *name) {
+#ifdef _WIN32
+	HMODULE lib = GetModuleHandleA("OpenCL.dll");
+	return lib ? reinterpret_cast<void*>(GetProcAddress(lib, name)) : nullptr;
+#else
+	return dlsym(RTLD_DEFAULT, name);
+#endif
+}
+
 const char* getExceptionMessage(const cl_int code) {
 	switch (code) {
 		case CL_SUCCESS:
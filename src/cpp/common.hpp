@@ -33,6 +33,9 @@ namespace opencl {
 
 void getPtrAndLen(Napi::Object obj, void** ptr, size_t *len);
 const char* getExceptionMessage(cl_int code);
+// Looks up an entry point of the loaded OpenCL library, `nullptr` if missing.
+// For the functions newer than CL_TARGET_OPENCL_VERSION
+void* getClFunction(const char *name);
 
 inline Napi::Number NewInt64(napi_env env, int64_t val) {
 	napi_value value;
@@ -43,21 +46,43 @@ inline Napi::Number NewInt64(napi_env env, int64_t val) {
 
 #define RET_X64(VAL) return NewInt64(env, static_cast<int64_t>(VAL))
 
+JS_METHOD(setAutoRelease);
+JS_METHOD(getLiveObjectCounts);
+JS_METHOD(setObjectTracking);
+JS_METHOD(getObjectStats);
+JS_METHOD(getLiveObjects);
+
 JS_METHOD(createKernel);
+JS_METHOD(cloneKernel);
 JS_METHOD(createKernelsInProgram);
 JS_METHOD(retainKernel);
 JS_METHOD(releaseKernel);
 JS_METHOD(setKernelArg);
+JS_METHOD(setKernelArgs);
+JS_METHOD(setKernelArgTypes);
 JS_METHOD(getKernelInfo);
 JS_METHOD(getKernelArgInfo);
 JS_METHOD(getKernelWorkGroupInfo);
 
 JS_METHOD(createBuffer);
+JS_METHOD(createBufferFromFile);
 JS_METHOD(createSubBuffer);
 JS_METHOD(createImage);
 JS_METHOD(retainMemObject);
 JS_METHOD(releaseMemObject);
+JS_METHOD(createPooledBuffer);
+JS_METHOD(releasePooledBuffer);
+JS_METHOD(trimBufferPool);
+JS_METHOD(setBufferPoolLimit);
+JS_METHOD(getBufferPoolStats);
 JS_METHOD(getSupportedImageFormats);
+JS_METHOD(acquireStagingBuffer);
+JS_METHOD(releaseStagingBuffer);
+JS_METHOD(trimStagingBuffers);
+JS_METHOD(svmAlloc);
+JS_METHOD(svmFree);
+JS_METHOD(setKernelArgSVMPointer);
+JS_METHOD(setKernelExecInfo);
 JS_METHOD(getMemObjectInfo);
 JS_METHOD(getImageInfo);
 JS_METHOD(createFromGLBuffer);
@@ -69,10 +94,12 @@ JS_METHOD(getPlatformInfo);
 
 JS_METHOD(createProgramWithSource);
 JS_METHOD(createProgramWithBinary);
+JS_METHOD(createProgramWithIL);
 JS_METHOD(createProgramWithBuiltInKernels);
 JS_METHOD(retainProgram);
 JS_METHOD(releaseProgram);
 JS_METHOD(buildProgram);
+JS_METHOD(buildProgramAsync);
 JS_METHOD(compileProgram);
 JS_METHOD(linkProgram);
 JS_METHOD(unloadPlatformCompiler);
@@ -90,21 +117,29 @@ JS_METHOD(releaseCommandQueue);
 JS_METHOD(getCommandQueueInfo);
 JS_METHOD(flush);
 JS_METHOD(finish);
+JS_METHOD(finishAsync);
 JS_METHOD(enqueueReadBuffer);
+JS_METHOD(enqueueReadBufferAsync);
 JS_METHOD(enqueueReadBufferRect);
 JS_METHOD(enqueueWriteBuffer);
+JS_METHOD(enqueueWriteBufferAsync);
 JS_METHOD(enqueueWriteBufferRect);
 JS_METHOD(enqueueCopyBuffer);
 JS_METHOD(enqueueCopyBufferRect);
 JS_METHOD(enqueueReadImage);
+JS_METHOD(enqueueReadImageAsync);
 JS_METHOD(enqueueWriteImage);
+JS_METHOD(enqueueWriteImageAsync);
 JS_METHOD(enqueueCopyImage);
 JS_METHOD(enqueueCopyImageToBuffer);
 JS_METHOD(enqueueCopyBufferToImage);
 JS_METHOD(enqueueMapBuffer);
+JS_METHOD(enqueueMapBufferAsync);
 JS_METHOD(enqueueMapImage);
+JS_METHOD(enqueueMapImageAsync);
 JS_METHOD(enqueueUnmapMemObject);
 JS_METHOD(enqueueNDRangeKernel);
+JS_METHOD(dispatch);
 JS_METHOD(enqueueTask);
 JS_METHOD(enqueueNativeKernel);
 JS_METHOD(enqueueMarkerWithWaitList);
@@ -116,6 +151,10 @@ JS_METHOD(enqueueFillImage);
 JS_METHOD(enqueueMigrateMemObjects);
 JS_METHOD(enqueueAcquireGLObjects);
 JS_METHOD(enqueueReleaseGLObjects);
+JS_METHOD(enqueueSVMMap);
+JS_METHOD(enqueueSVMUnmap);
+JS_METHOD(enqueueSVMMemcpy);
+JS_METHOD(enqueueSVMMemFill);
 
 JS_METHOD(createContext);
 JS_METHOD(createContextFromType);
@@ -130,6 +169,10 @@ JS_METHOD(retainDevice);
 JS_METHOD(releaseDevice);
 
 JS_METHOD(waitForEvents);
+JS_METHOD(waitForEventsAsync);
+JS_METHOD(releaseEventHandle);
+JS_METHOD(eventFromHandle);
+JS_METHOD(getEventHandleCount);
 JS_METHOD(getEventInfo);
 JS_METHOD(createUserEvent);
 JS_METHOD(retainEvent);
@@ -1,4 +1,6 @@
 #include "wrapper.hpp"
+#include "svm.hpp"
+#include "il.hpp"
 
 
 namespace opencl {
@@ -219,7 +221,8 @@ inline Napi::Value getDeviceInfoSize(Napi::Env env, cl_device_id device_id, uint
 	case CL_DEVICE_PROFILE:                                                            \
 	case CL_DEVICE_VERSION:                                                            \
 	case CL_DEVICE_OPENCL_C_VERSION:                                                   \
-	case CL_DEVICE_EXTENSIONS:
+	case CL_DEVICE_EXTENSIONS:                                                         \
+	case CL_DEVICE_IL_VERSION:
 
 #define CASES_CL_FP                                                                    \
 	case CL_DEVICE_HALF_FP_CONFIG:                                                     \
@@ -309,7 +312,8 @@ inline Napi::Value getDeviceInfoSize(Napi::Env env, cl_device_id device_id, uint
 	case CL_DEVICE_GLOBAL_MEM_SIZE:                                                    \
 	case CL_DEVICE_LOCAL_MEM_SIZE:                                                     \
 	case CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE:                                           \
-	case CL_DEVICE_MAX_MEM_ALLOC_SIZE:
+	case CL_DEVICE_MAX_MEM_ALLOC_SIZE:                                                 \
+	case CL_DEVICE_SVM_CAPABILITIES:
 
 #define CASES_CL_SIZE                                                                  \
 	case CL_DEVICE_IMAGE2D_MAX_HEIGHT:                                                 \
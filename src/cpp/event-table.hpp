@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include "common.hpp"
+
+
+namespace opencl {
+
+// The `hasEvent` value that requests a numeric event handle, see EventTable
+#define EVENT_HANDLE_FLAG 2
+
+#define IS_EVENT_HANDLE_FLAG(n)                                               \
+	(!IS_ARG_EMPTY(n) && info[n].IsNumber() &&                                \
+	info[n].As<Napi::Number>().Int32Value() == EVENT_HANDLE_FLAG)
+
+#define RET_EVENT_HANDLE(E)                                                   \
+	{                                                                         \
+		double _handle = EventTable::insert(E);                               \
+		if (!_handle) {                                                       \
+			clReleaseEvent(E);                                                \
+			THROW_ERR(CL_OUT_OF_HOST_MEMORY);                                 \
+		}                                                                     \
+		RET_NUM(_handle);                                                     \
+	}
+
+// Numeric handles to native events, so that chained commands don't allocate
+// a JS Wrapper per event. A handle is `generation * 2^24 + slot`, a reused
+// slot gets the next generation, so a stale handle never resolves.
+// The table owns the events until a handle is taken (e.g. by a wait list).
+class EventTable {
+public:
+	// Returns 0 if there are no free slots left
+	static double insert(cl_event event) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		
+		uint32_t slot;
+		if (!_free.empty()) {
+			slot = _free.back();
+			_free.pop_back();
+		} else if (_events.size() < SLOT_COUNT) {
+			slot = static_cast<uint32_t>(_events.size());
+			_events.push_back(nullptr);
+			_generations.push_back(0);
+		} else {
+			return 0;
+		}
+		
+		uint32_t generation = _generations[slot] + 1;
+		_generations[slot] = generation < GENERATION_COUNT ? generation : 1;
+		_events[slot] = event;
+		
+		return static_cast<double>(_generations[slot]) * SLOT_COUNT + slot;
+	}
+	
+	// Looks the event up, the table still owns it.
+	// Returns `nullptr` for unknown and already taken handles
+	static cl_event peek(double handle) {
+		uint32_t slot = 0;
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _find(handle, &slot) ? _events[slot] : nullptr;
+	}
+	
+	// Removes the event from the table, the caller is now in charge of it.
+	// Returns `nullptr` for unknown and already taken handles
+	static cl_event take(double handle) {
+		uint32_t slot = 0;
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_find(handle, &slot)) {
+			return nullptr;
+		}
+		
+		cl_event event = _events[slot];
+		_events[slot] = nullptr;
+		_free.push_back(slot);
+		return event;
+	}
+	
+	static size_t count() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		return _events.size() - _free.size();
+	}
+
+private:
+	static constexpr uint32_t SLOT_COUNT = 1u << 24;
+	// Keeps the handles within the exact integer range of a JS Number
+	static constexpr uint32_t GENERATION_COUNT = 1u << 29;
+	
+	inline static std::mutex _mutex;
+	inline static std::vector<cl_event> _events;
+	inline static std::vector<uint32_t> _generations;
+	inline static std::vector<uint32_t> _free;
+	
+	// The slot of a live handle, call with `_mutex` locked
+	static bool _find(double handle, uint32_t *slot) {
+		if (!(handle > 0) || handle != std::floor(handle)) {
+			return false;
+		}
+		
+		double generation = std::floor(handle / SLOT_COUNT);
+		if (generation >= GENERATION_COUNT) {
+			return false;
+		}
+		*slot = static_cast<uint32_t>(handle - generation * SLOT_COUNT);
+		
+		return *slot < _events.size() &&
+			_generations[*slot] == generation &&
+			_events[*slot] != nullptr;
+	}
+};
+
+
+// The handles of a wait list. They stay in the table until the command that
+// waits for them is enqueued. When this goes out of scope without a pending
+// JS exception, the handles are taken and their events released. A rejected
+// wait list or a failed enqueue leaves the caller's handles intact
+class ConsumedEvents {
+public:
+	explicit ConsumedEvents(Napi::Env env): _env(env) {}
+	
+	~ConsumedEvents() {
+		if (_env.IsExceptionPending()) {
+			return;
+		}
+		for (double handle : _handles) {
+			cl_event event = EventTable::take(handle);
+			if (event) {
+				clReleaseEvent(event);
+			}
+		}
+	}
+	
+	void push(double handle) {
+		_handles.push_back(handle);
+	}
+	
+	// Takes the events now and hands them over to the caller, who has to release them
+	std::vector<cl_event> detach() {
+		std::vector<cl_event> events;
+		for (double handle : _handles) {
+			cl_event event = EventTable::take(handle);
+			if (event) {
+				events.push_back(event);
+			}
+		}
+		_handles.clear();
+		return events;
+	}
+
+private:
+	Napi::Env _env;
+	std::vector<double> _handles;
+};
+
+} // namespace opencl
@@ -3,6 +3,7 @@
 #include "wrapper.hpp"
 #include "common.hpp"
 #include "notify-helper.hpp"
+#include "promise-helper.hpp"
 
 
 namespace opencl {
@@ -18,6 +19,53 @@ JS_METHOD(waitForEvents) { NAPI_ENV;
 	RET_UNDEFINED;
 }
 
+JS_METHOD(waitForEventsAsync) { NAPI_ENV;
+	GET_WAIT_LIST(0);
+	
+	if (cl_events.empty()) {
+		THROW_ERR(CL_INVALID_VALUE);
+	}
+	
+	PromiseHelper *helper = new PromiseHelper(env, env.Undefined(), info[0]);
+	for (cl_event event : consumed_events.detach()) {
+		helper->own(event);
+	}
+	for (cl_event event : cl_events) {
+		if (helper->watch(event) != CL_SUCCESS) {
+			break;
+		}
+	}
+	
+	RET_VALUE(helper->start());
+}
+
+JS_METHOD(releaseEventHandle) { NAPI_ENV;
+	REQ_DOUBLE_ARG(0, handle);
+	
+	cl_event event = EventTable::take(handle);
+	if (!event) {
+		THROW_ERR(CL_INVALID_EVENT);
+	}
+	
+	CHECK_ERR(clReleaseEvent(event));
+	RET_UNDEFINED;
+}
+
+JS_METHOD(eventFromHandle) { NAPI_ENV;
+	REQ_DOUBLE_ARG(0, handle);
+	
+	cl_event event = EventTable::take(handle);
+	if (!event) {
+		THROW_ERR(CL_INVALID_EVENT);
+	}
+	
+	RET_WRAPPER(event);
+}
+
+JS_METHOD(getEventHandleCount) { NAPI_ENV;
+	RET_NUM(EventTable::count());
+}
+
 JS_METHOD(getEventInfo) { NAPI_ENV;
 	REQ_CL_ARG(0, ev, cl_event);
 	REQ_UINT32_ARG(1, param_name);
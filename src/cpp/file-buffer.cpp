@@ -0,0 +1,221 @@
+#include "win32.hpp"
+
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+#include <cmath>
+
+#include "wrapper.hpp"
+
+
+namespace opencl {
+
+// A private (copy-on-write) view of a file region. The view starts at a page
+// boundary, `data` points at the requested offset within it
+struct FileView {
+	void *base;
+	size_t baseSize;
+	void *data;
+	size_t size;
+};
+
+
+static size_t getPageSize() {
+#ifdef _WIN32
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	// Views must start at the allocation granularity, not just a page
+	return sysInfo.dwAllocationGranularity;
+#else
+	return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+
+// Maps `size` bytes at `offset`, or up to the end of file if `size` is 0.
+// Returns an error message, or `nullptr` on success
+static const char* mapFileView(
+	const std::string &path, size_t offset, size_t size, FileView *view
+) {
+	size_t pageSize = getPageSize();
+	size_t baseOffset = offset - offset % pageSize;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(
+		path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr
+	);
+	if (file == INVALID_HANDLE_VALUE) {
+		return "Could not open the file.";
+	}
+	
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return "Could not read the file size.";
+	}
+	size_t total = static_cast<size_t>(fileSize.QuadPart);
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0) {
+		return "Could not open the file.";
+	}
+	
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0) {
+		close(file);
+		return "Could not read the file size.";
+	}
+	size_t total = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	if (offset >= total || size > total - offset) {
+#ifdef _WIN32
+		CloseHandle(file);
+#else
+		close(file);
+#endif
+		return "The range is out of the file bounds.";
+	}
+	if (!size) {
+		size = total - offset;
+	}
+	
+	view->baseSize = size + (offset - baseOffset);
+	view->size = size;
+
+#ifdef _WIN32
+	// The view stays valid after both handles are closed
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (!mapping) {
+		return "Could not map the file.";
+	}
+	view->base = MapViewOfFile(
+		mapping, FILE_MAP_COPY,
+		static_cast<DWORD>(static_cast<uint64_t>(baseOffset) >> 32),
+		static_cast<DWORD>(baseOffset & 0xFFFFFFFF),
+		view->baseSize
+	);
+	CloseHandle(mapping);
+	if (!view->base) {
+		return "Could not map the file.";
+	}
+#else
+	// Writable, so that the device may write to a USE_HOST_PTR buffer,
+	// but private, so that the file itself never changes
+	view->base = mmap(
+		nullptr, view->baseSize, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+		file, static_cast<off_t>(baseOffset)
+	);
+	close(file);
+	if (view->base == MAP_FAILED) {
+		view->base = nullptr;
+		return "Could not map the file.";
+	}
+#endif
+
+	view->data = static_cast<uint8_t*>(view->base) + (offset - baseOffset);
+	return nullptr;
+}
+
+
+static void unmapFileView(FileView *view) {
+#ifdef _WIN32
+	UnmapViewOfFile(view->base);
+#else
+	munmap(view->base, view->baseSize);
+#endif
+	delete view;
+}
+
+
+static void CL_CALLBACK fileBufferDestroyed(cl_mem, void *ptr) {
+	unmapFileView(reinterpret_cast<FileView*>(ptr));
+}
+
+
+// Reads an optional size field of `range`. Anything but a finite, non-negative
+// integer would be undefined when cast to size_t
+static bool readRangeField(Napi::Object range, const char *name, size_t *out) {
+	*out = 0;
+	Napi::Value value = range.Get(name);
+	if (IS_EMPTY(value)) {
+		return true;
+	}
+	if (!value.IsNumber()) {
+		return false;
+	}
+	double number = value.ToNumber().DoubleValue();
+	if (!std::isfinite(number) || number < 0 || std::floor(number) != number) {
+		return false;
+	}
+	*out = static_cast<size_t>(number);
+	return true;
+}
+
+
+// By default, the buffer uses the mapped file as its host memory, so only the
+// pages that the device reads are loaded. With MEM_COPY_HOST_PTR in `flags`,
+// the data is copied once and the file is unmapped right away
+JS_METHOD(createBufferFromFile) { NAPI_ENV;
+	REQ_CL_ARG(0, context, cl_context);
+	REQ_STR_ARG(1, path);
+	USE_OFFS_ARG(2, flags, 0);
+	LET_OBJ_ARG(3, range);
+	
+	size_t offset = 0;
+	if (!readRangeField(range, "offset", &offset)) {
+		JS_THROW("Argument 3 `offset` must be a non-negative integer.");
+		RET_UNDEFINED;
+	}
+	size_t length = 0;
+	if (!readRangeField(range, "length", &length)) {
+		JS_THROW("Argument 3 `length` must be a non-negative integer.");
+		RET_UNDEFINED;
+	}
+	
+	if (!(flags & (CL_MEM_READ_WRITE | CL_MEM_WRITE_ONLY | CL_MEM_READ_ONLY))) {
+		flags |= CL_MEM_READ_ONLY;
+	}
+	bool isCopy = (flags & CL_MEM_COPY_HOST_PTR) != 0;
+	flags &= ~static_cast<cl_mem_flags>(CL_MEM_USE_HOST_PTR | CL_MEM_ALLOC_HOST_PTR);
+	if (!isCopy) {
+		flags |= CL_MEM_USE_HOST_PTR;
+	}
+	
+	FileView *view = new FileView { nullptr, 0, nullptr, 0 };
+	const char *msg = mapFileView(path, offset, length, view);
+	if (msg) {
+		delete view;
+		JS_THROW(std::string(msg) + " " + path);
+		RET_UNDEFINED;
+	}
+	
+	cl_int err = CL_SUCCESS;
+	cl_mem mem = clCreateBuffer(context, flags, view->size, view->data, &err);
+	if (err != CL_SUCCESS) {
+		unmapFileView(view);
+		THROW_ERR(err);
+	}
+	
+	if (isCopy) {
+		unmapFileView(view);
+		RET_WRAPPER(mem);
+	}
+	
+	err = clSetMemObjectDestructorCallback(mem, fileBufferDestroyed, view);
+	if (err != CL_SUCCESS) {
+		clReleaseMemObject(mem);
+		unmapFileView(view);
+		THROW_ERR(err);
+	}
+	
+	RET_WRAPPER(mem);
+}
+
+} // namespace opencl
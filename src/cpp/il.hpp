@@ -0,0 +1,19 @@
+#pragma once
+
+#include "wrapper.hpp"
+
+
+// OpenCL 2.1 definitions, the same values as in cl_khr_il_program
+#ifndef CL_VERSION_2_1
+	#define CL_DEVICE_IL_VERSION 0x105B
+	#define CL_PROGRAM_IL 0x1169
+#endif
+
+
+namespace opencl {
+
+typedef cl_program (CL_API_CALL *CreateProgramWithILFn)(
+	cl_context, const void*, size_t, cl_int*
+);
+
+} // namespace opencl
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "wrapper.hpp"
+
+namespace opencl {
+
+// References a JS value (e.g. the host memory of a transfer) until an event
+// completes, or a mem object is destroyed. The CL callbacks fire on driver
+// threads, the TSFN finalizer drops the reference on the JS thread.
+class KeepAliveHelper {
+public:
+	static cl_int untilComplete(Napi::Env env, cl_event event, Napi::Value value) {
+		KeepAliveHelper *helper = new KeepAliveHelper(env, value);
+		cl_int err = clSetEventCallback(event, CL_COMPLETE, _eventDone, helper);
+		if (err != CL_SUCCESS) {
+			helper->_done();
+		}
+		return err;
+	}
+	
+	// A buffer may live for long, so it doesn't keep the event loop running
+	static cl_int untilDestroyed(Napi::Env env, cl_mem mem, Napi::Value value) {
+		KeepAliveHelper *helper = new KeepAliveHelper(env, value);
+		helper->_tsfn.Unref(env);
+		cl_int err = clSetMemObjectDestructorCallback(mem, _memDone, helper);
+		if (err != CL_SUCCESS) {
+			helper->_done();
+		}
+		return err;
+	}
+
+private:
+	Napi::ObjectReference _ref;
+	Napi::ThreadSafeFunction _tsfn;
+	
+	KeepAliveHelper(Napi::Env env, Napi::Value value) {
+		_ref.Reset(Napi::Object::New(env), 1);
+		_ref.Set("value", value);
+		
+		void *context = nullptr;
+		_tsfn = Napi::ThreadSafeFunction::New(
+			env, Napi::Function(), "KeepAliveHelper", 0LLU, 1LLU, context, _delete, this
+		);
+	}
+	
+	~KeepAliveHelper() {
+		_ref.Reset();
+	}
+	
+	static void _delete(napi_env env, KeepAliveHelper* that, void*) {
+		delete that;
+	}
+	
+	static void CL_CALLBACK _eventDone(cl_event, cl_int, void *ptr) {
+		reinterpret_cast<KeepAliveHelper*>(ptr)->_done();
+	}
+	
+	static void CL_CALLBACK _memDone(cl_mem, void *ptr) {
+		reinterpret_cast<KeepAliveHelper*>(ptr)->_done();
+	}
+	
+	// The last TSFN release schedules the finalizer on the JS thread
+	void _done() {
+		_tsfn.Release();
+	}
+};
+
+} // namespace opencl
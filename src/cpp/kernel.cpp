@@ -1,7 +1,4 @@
 #include <unordered_map>
-#include <functional>
-#include <utility>
-#include <tuple>
 
 #include "wrapper.hpp"
 
@@ -19,6 +16,48 @@ JS_METHOD(createKernel) { NAPI_ENV;
 	RET_WRAPPER(k);
 }
 
+typedef cl_kernel (CL_API_CALL *CloneKernelFn)(cl_kernel, cl_int*);
+
+// OpenCL 2.1 copies the arg values too. Older libraries get a new kernel of the
+// same function, so only the arg types (cached by the Wrapper) carry over
+JS_METHOD(cloneKernel) { NAPI_ENV;
+	REQ_WRAP_ARG(0, kernelWrapper);
+	
+	static CloneKernelFn cloneFn = reinterpret_cast<CloneKernelFn>(
+		getClFunction("clCloneKernel")
+	);
+	
+	cl_kernel kernel = kernelWrapper->as<cl_kernel>();
+	cl_int ret = CL_SUCCESS;
+	cl_kernel k = nullptr;
+	
+	if (cloneFn) {
+		k = cloneFn(kernel, &ret);
+	}
+	
+	// Some ICD loaders export clCloneKernel for platforms that don't have it
+	if (!cloneFn || ret == CL_INVALID_OPERATION) {
+		cl_program program = nullptr;
+		CHECK_ERR(clGetKernelInfo(
+			kernel, CL_KERNEL_PROGRAM, sizeof(cl_program), &program, nullptr
+		));
+		
+		size_t nameSize = 0;
+		CHECK_ERR(clGetKernelInfo(kernel, CL_KERNEL_FUNCTION_NAME, 0, nullptr, &nameSize));
+		std::vector<char> name(nameSize);
+		CHECK_ERR(clGetKernelInfo(
+			kernel, CL_KERNEL_FUNCTION_NAME, nameSize, name.data(), nullptr
+		));
+		
+		k = clCreateKernel(program, name.data(), &ret);
+	}
+	CHECK_ERR(ret);
+	
+	Napi::Object result = Wrapper::from(env, k);
+	Wrapper::unwrap(result)->copyKernelArgs(env, kernelWrapper);
+	RET_VALUE(result);
+}
+
 JS_METHOD(createKernelsInProgram) { NAPI_ENV;
 	REQ_CL_ARG(0, program, cl_program);
 	
@@ -58,15 +97,56 @@ JS_METHOD(releaseKernel) { NAPI_ENV;
 	RET_UNDEFINED;
 }
 
+// Scalar conversion, writes the value into the caller-provided scratch
+template<typename TYPE>
+cl_int convertNumber(Napi::Value val, void *out, size_t *size) {
+	if (!val.IsNumber()) {
+		return CL_INVALID_ARG_VALUE;
+	}
+	*reinterpret_cast<TYPE*>(out) = static_cast<TYPE>(val.ToNumber().DoubleValue());
+	*size = sizeof(TYPE);
+	return CL_SUCCESS;
+}
+
+// Vector conversion (e.g. float4, int16, etc). Note: 3-component vectors
+// have the size and alignment of 4-component ones, the 4th item is zeroed
+template<typename TYPE, uint32_t I>
+cl_int convertVector(Napi::Value val, void *out, size_t *size) {
+	if (!val.IsArray()) {
+		return CL_INVALID_ARG_VALUE;
+	}
+	Napi::Array arr = val.As<Napi::Array>();
+	if (arr.Length() != I) {
+		return CL_INVALID_ARG_SIZE;
+	}
+	TYPE *vvc = reinterpret_cast<TYPE*>(out);
+	for (uint32_t i = 0; i < I; ++ i) {
+		Napi::Value item = arr.Get(i);
+		if (!item.IsNumber()) {
+			return CL_INVALID_ARG_VALUE;
+		}
+		vvc[i] = static_cast<TYPE>(item.ToNumber().DoubleValue());
+	}
+	if constexpr (I == 3) {
+		vvc[3] = 0;
+	}
+	*size = sizeof(TYPE) * (I == 3 ? 4 : I);
+	return CL_SUCCESS;
+}
+
+cl_int convertBool(Napi::Value val, void *out, size_t *size) {
+	*reinterpret_cast<cl_bool*>(out) = static_cast<cl_bool>(val.ToBoolean().Value() ? 1 : 0);
+	*size = sizeof(cl_bool);
+	return CL_SUCCESS;
+}
+
 // Caches OpenCL type name to conversion function mapping in a hash table
 // (unordered_map) for fast retrieval. This is much faster than the previous
 // approach of checking each possible type with strcmp in a huge if-else
 class PrimitiveTypeMapCache {
 private:
-	/// Type of the conversion function
-	typedef std::function<std::tuple<size_t, void*, cl_int>(Napi::Value)> func_t;
 	// map of conversion functions
-	std::unordered_map<std::string, func_t> m_converters;
+	std::unordered_map<std::string, ArgConverter> m_converters;
 public:
 	PrimitiveTypeMapCache() {
 		// if we create the TypeMap as a static function member, the constructor
@@ -78,230 +158,364 @@ public:
 		
 		/* convert primitive types */
 		
-		#define CONVERT_NUMBER(NAME, TYPE, CONV) {                                    \
-			func_t f = [](Napi::Value val) -> std::tuple<size_t, void*, cl_int> {     \
-				if (!val.IsNumber()) {                                             \
-					return std::tuple<size_t, void*, cl_int>(                         \
-						0,                                                            \
-						nullptr,                                                      \
-						CL_INVALID_ARG_VALUE                                          \
-					);                                                                \
-				}                                                                     \
-				TYPE* ptr_data = new TYPE;                                            \
-				size_t ptr_size = sizeof(TYPE);                                       \
-				*ptr_data = static_cast<TYPE>(val.ToNumber().DoubleValue());          \
-				return std::tuple<size_t, void*, cl_int>(                             \
-					ptr_size,                                                         \
-					ptr_data,                                                         \
-					0                                                                 \
-				);                                                                    \
-			};                                                                        \
-			m_converters[NAME] = f;                                                   \
-		}
+		#define CONVERT_NUMBER(NAME, TYPE)                                            \
+			m_converters[NAME] = convertNumber<TYPE>;
 		
-		CONVERT_NUMBER("char", cl_char, int32_t);
-		CONVERT_NUMBER("uchar", cl_uchar, uint32_t);
-		CONVERT_NUMBER("short", cl_short, int32_t);
-		CONVERT_NUMBER("ushort", cl_ushort, uint32_t);
-		CONVERT_NUMBER("int", cl_int , int32_t);
-		CONVERT_NUMBER("uint", cl_uint, uint32_t);
-		CONVERT_NUMBER("long", cl_long, int64_t);
-		CONVERT_NUMBER("ulong", cl_ulong, int64_t);
-		CONVERT_NUMBER("float", cl_float, double);
-		CONVERT_NUMBER("double", cl_double, double);
-		CONVERT_NUMBER("half", cl_half, double);
+		CONVERT_NUMBER("char", cl_char);
+		CONVERT_NUMBER("uchar", cl_uchar);
+		CONVERT_NUMBER("short", cl_short);
+		CONVERT_NUMBER("ushort", cl_ushort);
+		CONVERT_NUMBER("int", cl_int);
+		CONVERT_NUMBER("uint", cl_uint);
+		CONVERT_NUMBER("long", cl_long);
+		CONVERT_NUMBER("ulong", cl_ulong);
+		CONVERT_NUMBER("float", cl_float);
+		CONVERT_NUMBER("double", cl_double);
+		CONVERT_NUMBER("half", cl_half);
 		
 		#undef CONVERT_NUMBER
 		
 		/* convert vector types (e.g. float4, int16, etc) */
 		
-		#define CONVERT_VECT(NAME, TYPE, I, COND) {                                   \
-			func_t f = [](Napi::Value val) -> std::tuple<size_t, void*, cl_int> {     \
-				if (!val.IsArray()) {                                              \
-					/*THROW_ERR(CL_INVALID_ARG_VALUE);  */                            \
-					return std::tuple<size_t, void*, cl_int>(                         \
-						0,                                                            \
-						nullptr,                                                      \
-						CL_INVALID_ARG_VALUE                                          \
-					);                                                                \
-				}                                                                     \
-				Napi::Array arr = val.As<Napi::Array>();                              \
-				if (arr.Length() != I) {                                              \
-					/*THROW_ERR(CL_INVALID_ARG_SIZE);*/                               \
-					return std::tuple<size_t, void*, cl_int>(                         \
-						0,                                                            \
-						nullptr,                                                      \
-						CL_INVALID_ARG_SIZE                                           \
-					);                                                                \
-				}                                                                     \
-				TYPE * vvc = new TYPE[I];                                             \
-				size_t ptr_size = sizeof(TYPE) * I;                                   \
-				void* ptr_data = vvc;                                                 \
-				for (unsigned int i = 0; i < I; ++ i) {                               \
-					if (!arr.Get(i).IsNumber()) {                                  \
-						/*THROW_ERR(CL_INVALID_ARG_VALUE);*/                          \
-						/*THROW_ERR(CL_INVALID_ARG_VALUE);*/                          \
-						return std::tuple<size_t, void*, cl_int>(                     \
-							0,                                                        \
-							nullptr,                                                  \
-							CL_INVALID_ARG_VALUE                                      \
-						);                                                            \
-					}                                                                 \
-					vvc[i] = (TYPE) arr.Get(i).ToNumber().DoubleValue();              \
-				}                                                                     \
-				return std::tuple<size_t, void*, cl_int>(ptr_size, ptr_data, 0);      \
-			};                                                                        \
-			m_converters[NAME #I ] = f;                                               \
-		}
-		
-		#define CONVERT_VECTS(NAME, TYPE, COND)                                       \
-			CONVERT_VECT(NAME, TYPE, 2, COND);                                        \
-			CONVERT_VECT(NAME, TYPE, 3, COND);                                        \
-			CONVERT_VECT(NAME, TYPE, 4, COND);                                        \
-			CONVERT_VECT(NAME, TYPE, 8, COND);                                        \
-			CONVERT_VECT(NAME, TYPE, 16, COND);
+		#define CONVERT_VECTS(NAME, TYPE)                                             \
+			m_converters[NAME "2"] = convertVector<TYPE, 2>;                          \
+			m_converters[NAME "3"] = convertVector<TYPE, 3>;                          \
+			m_converters[NAME "4"] = convertVector<TYPE, 4>;                          \
+			m_converters[NAME "8"] = convertVector<TYPE, 8>;                          \
+			m_converters[NAME "16"] = convertVector<TYPE, 16>;
 		
-		CONVERT_VECTS("char", cl_char, int32_t);
-		CONVERT_VECTS("uchar", cl_uchar, int32_t);
-		CONVERT_VECTS("short", cl_short, int32_t);
-		CONVERT_VECTS("ushort", cl_ushort, int32_t);
-		CONVERT_VECTS("int", cl_int, int32_t);
-		CONVERT_VECTS("uint", cl_uint, uint32_t);
-		CONVERT_VECTS("long", cl_long, int64_t);
-		CONVERT_VECTS("ulong", cl_ulong, int64_t);
-		CONVERT_VECTS("float", cl_float, double);
-		CONVERT_VECTS("double", cl_double, double);
-		CONVERT_VECTS("half", cl_half, double);
+		CONVERT_VECTS("char", cl_char);
+		CONVERT_VECTS("uchar", cl_uchar);
+		CONVERT_VECTS("short", cl_short);
+		CONVERT_VECTS("ushort", cl_ushort);
+		CONVERT_VECTS("int", cl_int);
+		CONVERT_VECTS("uint", cl_uint);
+		CONVERT_VECTS("long", cl_long);
+		CONVERT_VECTS("ulong", cl_ulong);
+		CONVERT_VECTS("float", cl_float);
+		CONVERT_VECTS("double", cl_double);
+		CONVERT_VECTS("half", cl_half);
 		
-		#undef CONVERT_VECT
 		#undef CONVERT_VECTS
 		
 		// add boolean conversion
-		m_converters["bool"] = [](Napi::Value val) {
-			size_t ptr_size = sizeof(cl_bool);
-			cl_bool* ptr_data = new cl_bool;
-			*ptr_data = static_cast<cl_bool>(val.ToBoolean().Value() ? 1 : 0);
-			return std::tuple<size_t, void*, cl_int>(ptr_size, ptr_data, 0);
-		};
-	}
-	
-	/// Returns wheather the type given is in the map, i.e. if it is a
-	/// primitive type
-	bool hasType(const std::string& name) {
-		return m_converters.find(name) != m_converters.end();
+		m_converters["bool"] = convertBool;
 	}
 	
-	// Converts the given JS value to the OpenCL type given by the `name`
-	// parameter and returns the result as a pair of the size of the converted
-	// value and the pointer as `void*`. The caller is responsible
-	// for deleting the pointer after use.
-	std::tuple<size_t, void*, cl_int> convert(const std::string& name, Napi::Value val) {
-		// call conversion function and return size of argument and pointer
-		return m_converters[name](val);
+	// Classifies the argument by its type name, so that it can be cached
+	KernelArg resolve(const std::string& name, bool isLocal) {
+		if (isLocal) {
+			return { KernelArg::Local, nullptr };
+		}
+		if (!name.empty() && ('*' == name[name.length() - 1] || name == "cl_mem")) {
+			return { KernelArg::Mem, nullptr };
+		}
+		if (name == "sampler_t") {
+			return { KernelArg::Sampler, nullptr };
+		}
+		auto it = m_converters.find(name);
+		if (it != m_converters.end()) {
+			return { KernelArg::Primitive, it->second };
+		}
+		return { KernelArg::Unknown, nullptr };
 	}
 };
 
-JS_METHOD(setKernelArg) { NAPI_ENV;
+KernelArg resolveKernelArgType(const std::string &type_name) {
 	// static member of the function gets initialized by the first thread
 	// which calls this function. This is thread-safe according to the C++11 standard.
 	// All other threads arriving wait till the constructor initialization is
 	// complete before executing the code below.
 	static PrimitiveTypeMapCache type_converter;
 	
-	REQ_CL_ARG(0, kernel, cl_kernel);
-	REQ_UINT32_ARG(1, arg_idx);
+	return type_converter.resolve(
+		type_name, type_name == "local" || type_name == "__local"
+	);
+}
+
+cl_int resolveKernelArg(
+	Wrapper *kernelWrapper, cl_uint arg_idx, KernelArg *arg, std::string *type_name
+) {
+	// the introspected signature is cached on the kernel wrapper
+	const KernelArg *cached = kernelWrapper->findKernelArg(arg_idx);
+	if (cached) {
+		*arg = *cached;
+		return CL_SUCCESS;
+	}
 	
-	// get type and qualifier of kernel parameter with this index
-	// using OpenCL, and then try to convert arg[2] to the type the kernel
-	// expects
+	cl_kernel kernel = kernelWrapper->as<cl_kernel>();
 	
-	// check if we have kernel introspection available
-	std::string type_name;
-	bool local_arg = false;
 	// get address qualifier of kernel (local, global, constant, private), one of:
 	// - CL_KERNEL_ARG_ADDRESS_GLOBAL
 	// - CL_KERNEL_ARG_ADDRESS_LOCAL
 	// - CL_KERNEL_ARG_ADDRESS_CONSTANT
 	// - CL_KERNEL_ARG_ADDRESS_PRIVATE
+	cl_kernel_arg_address_qualifier adrqual;
+	cl_int err = clGetKernelArgInfo(
+		kernel,
+		arg_idx,
+		CL_KERNEL_ARG_ADDRESS_QUALIFIER,
+		sizeof(cl_kernel_arg_address_qualifier),
+		&adrqual,
+		nullptr
+	);
+	if (err != CL_SUCCESS) {
+		return err;
+	}
+	
+	// get typename (for conversion of the JS parameter)
+	size_t nchars = 0;
+	err = clGetKernelArgInfo(
+		kernel,
+		arg_idx,
+		CL_KERNEL_ARG_TYPE_NAME,
+		0,
+		nullptr,
+		&nchars
+	);
+	if (err != CL_SUCCESS) {
+		return err;
+	}
+	std::unique_ptr<char[]> tname(new char[nchars]);
+	err = clGetKernelArgInfo(
+		kernel,
+		arg_idx,
+		CL_KERNEL_ARG_TYPE_NAME,
+		nchars,
+		tname.get(),
+		nullptr
+	);
+	if (err != CL_SUCCESS) {
+		return err;
+	}
+	
+	*type_name = std::string(tname.get());
+	*arg = adrqual == CL_KERNEL_ARG_ADDRESS_LOCAL
+		? resolveKernelArgType("local")
+		: resolveKernelArgType(*type_name);
+	
+	if (arg->kind != KernelArg::Unknown) {
+		kernelWrapper->cacheKernelArg(arg_idx, *arg);
+	}
+	
+	return CL_SUCCESS;
+}
+
+cl_int encodeKernelArg(
+	const KernelArg &arg, Napi::Value value, void *data, size_t *size, const char **msg
+) {
+	switch (arg.kind) {
+		case KernelArg::Local: {
+			if (!value.IsNumber()) {
+				*msg = "must be of type `Number`";
+				return CL_INVALID_ARG_VALUE;
+			}
+			*size = static_cast<size_t>(value.ToNumber().DoubleValue());
+			return CL_SUCCESS;
+		}
+		case KernelArg::Mem:
+		case KernelArg::Sampler: {
+			if (!value.IsObject()) {
+				*msg = "must be of type `Object`";
+				return CL_INVALID_ARG_VALUE;
+			}
+			Wrapper *wrapper = Wrapper::unwrap(value.As<Napi::Object>());
+			if (!wrapper) {
+				*msg = "must be a CL Wrapper.";
+				return CL_INVALID_ARG_VALUE;
+			}
+			// both cl_mem and cl_sampler are pointer-sized handles
+			*reinterpret_cast<void**>(data) = wrapper->as<void*>();
+			*size = sizeof(void*);
+			return CL_SUCCESS;
+		}
+		case KernelArg::Primitive:
+			// convert primitive types using the conversion
+			// function resolved by OpenCL type name
+			return arg.converter(value, data, size);
+		default:
+			// TODO: check for image_t types
+			// TODO: support queue_t and clk_event_t, and others?
+			return CL_INVALID_ARG_VALUE;
+	}
+}
+
+cl_int applyKernelArg(
+	cl_kernel kernel, cl_uint arg_idx, const KernelArg &arg, Napi::Value value,
+	const char **msg
+) {
+	alignas(16) uint8_t data[KERNEL_ARG_SCRATCH_SIZE];
+	size_t size = 0;
+	
+	cl_int err = encodeKernelArg(arg, value, data, &size, msg);
+	if (err != CL_SUCCESS) {
+		return err;
+	}
+	
+	return clSetKernelArg(
+		kernel, arg_idx, size, arg.kind == KernelArg::Local ? nullptr : data
+	);
+}
+
+JS_METHOD(setKernelArg) { NAPI_ENV;
+	REQ_WRAP_ARG(0, kernelWrapper);
+	cl_kernel kernel = kernelWrapper->as<cl_kernel>();
+	REQ_UINT32_ARG(1, arg_idx);
+	
+	// get type and qualifier of kernel parameter with this index
+	// using OpenCL, and then try to convert arg[2] to the type the kernel
+	// expects
+	std::string type_name;
+	KernelArg arg = { KernelArg::Unknown, nullptr };
+	
 	if (IS_ARG_EMPTY(2)) {
-		cl_kernel_arg_address_qualifier adrqual;
-		CHECK_ERR(clGetKernelArgInfo(
-			kernel,
-			arg_idx,
-			CL_KERNEL_ARG_ADDRESS_QUALIFIER,
-			sizeof(cl_kernel_arg_address_qualifier),
-			&adrqual,
-			nullptr
-		));
-		// get typename (for conversion of the JS parameter)
-		size_t nchars = 0;
-		CHECK_ERR(clGetKernelArgInfo(
-			kernel,
-			arg_idx,
-			CL_KERNEL_ARG_TYPE_NAME,
-			0,
-			nullptr,
-			&nchars
-		));
-		char* tname = new char[nchars];
-		CHECK_ERR(clGetKernelArgInfo(
-			kernel,
-			arg_idx,
-			CL_KERNEL_ARG_TYPE_NAME,
-			nchars,
-			tname,
-			nullptr
-		));
-		type_name = std::string(tname);
-		delete [] tname;
-		if (adrqual == CL_KERNEL_ARG_ADDRESS_LOCAL)
-			local_arg = true;
+		CHECK_ERR(resolveKernelArg(kernelWrapper, arg_idx, &arg, &type_name));
 	} else {
 		REQ_STR_ARG(2, tname);
-		const char* tname_c = tname.c_str();
-		size_t len = tname.length();
-		type_name.resize(len);
-		std::copy(tname_c, tname_c + len, type_name.begin());
-		if (type_name == "local" || type_name == "__local") {
-			local_arg = true;
-		}
+		type_name = tname;
+		arg = resolveKernelArgType(type_name);
 	}
 	
-	cl_int err = 0;
-	
-	if (local_arg) {
-		REQ_OFFS_ARG(3, local_size);
-		err = clSetKernelArg(kernel, arg_idx, local_size, nullptr);
-	} else if ('*' == type_name[type_name.length() - 1] || type_name == "cl_mem") {
-		REQ_CL_ARG(3, clMem, cl_mem);
-		err = clSetKernelArg(kernel, arg_idx, sizeof(cl_mem), &clMem);
-	} else if (type_name == "sampler_t") {
-		REQ_CL_ARG(3, clSampler, cl_sampler);
-		err = clSetKernelArg(kernel, arg_idx, sizeof(cl_sampler), &clSampler);
-	} else if (type_converter.hasType(type_name)) {
-		// convert primitive types using the conversion
-		// function map (indexed by OpenCL type name)
-		void* data;
-		size_t size;
-		
-		std::tie(size, data, err) = type_converter.convert(type_name, info[3]);
-		
-		CHECK_ERR(err);
-		err = clSetKernelArg(kernel, arg_idx, size, data);
-		free(data);
-	} else {
+	if (arg.kind == KernelArg::Unknown) {
 		std::string errstr = std::string("Unsupported OpenCL argument type: ") + type_name;
 		JS_THROW(errstr.c_str());
 		RET_UNDEFINED;
 	}
-	// TODO: check for image_t types
-	// TODO: support queue_t and clk_event_t, and others?
-	// Otherwise it should be a native type
+	
+	const char *msg = nullptr;
+	cl_int err = applyKernelArg(kernel, arg_idx, arg, info[3], &msg);
+	if (msg) {
+		JS_THROW(std::string("Argument 3 ") + msg);
+		RET_UNDEFINED;
+	}
 	
 	CHECK_ERR(err);
 	RET_NUM(err);
 }
 
+bool bindKernelArgs(
+	Napi::Env env, Wrapper *kernelWrapper, Napi::Array values, Napi::Value types
+) {
+	cl_kernel kernel = kernelWrapper->as<cl_kernel>();
+	
+	// types are optional, and so is each individual type
+	bool hasTypes = !IS_EMPTY(types);
+	if (hasTypes && !types.IsArray()) {
+		JS_THROW("Argument types must be an Array.");
+		return false;
+	}
+	
+	// All args are converted first, so that a bad one leaves the kernel as is
+	struct EncodedArg {
+		size_t size;
+		size_t offset;
+		bool isLocal;
+	};
+	uint32_t count = values.Length();
+	std::vector<EncodedArg> encoded(count);
+	std::vector<uint8_t> argData;
+	
+	for (uint32_t i = 0; i < count; i++) {
+		std::string type_name;
+		KernelArg arg = { KernelArg::Unknown, nullptr };
+		
+		Napi::Value type = hasTypes ? types.As<Napi::Array>().Get(i) : env.Undefined();
+		cl_int err = CL_SUCCESS;
+		if (IS_EMPTY(type)) {
+			err = resolveKernelArg(kernelWrapper, i, &arg, &type_name);
+		} else if (type.IsString()) {
+			type_name = type.ToString().Utf8Value();
+			arg = resolveKernelArgType(type_name);
+		} else {
+			Wrapper::throwArrayEx(env, i, "has a type that is not a String.");
+			return false;
+		}
+		
+		if (err == CL_SUCCESS && arg.kind == KernelArg::Unknown) {
+			std::string errstr = std::string("has unsupported OpenCL argument type: ") + type_name;
+			Wrapper::throwArrayEx(env, i, errstr.c_str());
+			return false;
+		}
+		
+		alignas(16) uint8_t data[KERNEL_ARG_SCRATCH_SIZE];
+		const char *msg = nullptr;
+		encoded[i] = { 0, argData.size(), arg.kind == KernelArg::Local };
+		if (err == CL_SUCCESS) {
+			err = encodeKernelArg(arg, values.Get(i), data, &encoded[i].size, &msg);
+		}
+		if (msg) {
+			Wrapper::throwArrayEx(env, i, msg);
+			return false;
+		}
+		if (err != CL_SUCCESS) {
+			std::string errstr = std::string("failed: ") + getExceptionMessage(err);
+			Wrapper::throwArrayEx(env, i, errstr.c_str());
+			return false;
+		}
+		if (!encoded[i].isLocal) {
+			argData.insert(argData.end(), data, data + encoded[i].size);
+		}
+	}
+	
+	for (uint32_t i = 0; i < count; i++) {
+		const EncodedArg &arg = encoded[i];
+		cl_int err = clSetKernelArg(
+			kernel, i, arg.size, arg.isLocal ? nullptr : &argData[arg.offset]
+		);
+		if (err != CL_SUCCESS) {
+			std::string errstr = std::string("failed: ") + getExceptionMessage(err);
+			Wrapper::throwArrayEx(env, i, errstr.c_str());
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+JS_METHOD(setKernelArgs) { NAPI_ENV;
+	REQ_WRAP_ARG(0, kernelWrapper);
+	REQ_ARRAY_ARG(1, values);
+	
+	Napi::Value types = env.Undefined();
+	if (!IS_ARG_EMPTY(2)) {
+		REQ_ARRAY_ARG(2, typesArray);
+		types = typesArray;
+	}
+	
+	if (!bindKernelArgs(env, kernelWrapper, values, types)) {
+		RET_UNDEFINED;
+	}
+	
+	RET_NUM(CL_SUCCESS);
+}
+
+// Seeds the signature cache, e.g. for programs from binaries, that may have no
+// arg info. Unknown types are skipped, returns how many types were cached
+JS_METHOD(setKernelArgTypes) { NAPI_ENV;
+	REQ_WRAP_ARG(0, kernelWrapper);
+	REQ_ARRAY_ARG(1, types);
+	
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < types.Length(); i++) {
+		Napi::Value type = types.Get(i);
+		if (IS_EMPTY(type)) {
+			continue;
+		}
+		if (!type.IsString()) {
+			Wrapper::throwArrayEx(env, i, "must be of type `String`");
+			RET_UNDEFINED;
+		}
+		
+		KernelArg arg = resolveKernelArgType(type.ToString().Utf8Value());
+		if (arg.kind != KernelArg::Unknown) {
+			kernelWrapper->cacheKernelArg(i, arg);
+			count++;
+		}
+	}
+	
+	RET_NUM(count);
+}
+
 JS_METHOD(getKernelInfo) { NAPI_ENV;
 	REQ_CL_ARG(0, kernel, cl_kernel);
 	REQ_UINT32_ARG(1, param_name);
@@ -0,0 +1,173 @@
+#include "mapping.hpp"
+
+
+namespace opencl {
+
+IMPLEMENT_ES5_CLASS(Mapping);
+
+
+void Mapping::init(Napi::Env env, Napi::Object exports) {
+	Napi::Function ctor = wrap(env);
+	JS_ASSIGN_METHOD(unmap);
+	JS_ASSIGN_GETTER(buffer);
+	JS_ASSIGN_GETTER(rowPitch);
+	JS_ASSIGN_GETTER(slicePitch);
+	JS_ASSIGN_GETTER(isMapped);
+	exports.Set("Mapping", ctor);
+}
+
+
+// The mapping is blocking, so the memory is ready when the constructor returns.
+// `(queue, buffer, flags, offset, size)` or `(queue, image, flags, origin, region)`
+Mapping::Mapping(const Napi::CallbackInfo& info) { NAPI_ENV;
+	super(info);
+	
+	_rowPitch = 0;
+	_slicePitch = 0;
+	
+	Wrapper *queueWrapper = info[0].IsObject()
+		? Wrapper::unwrap(info[0].As<Napi::Object>())
+		: nullptr;
+	if (!queueWrapper) {
+		JS_THROW("Argument 0 must be a CL Wrapper.");
+		return;
+	}
+	Wrapper *memWrapper = info[1].IsObject()
+		? Wrapper::unwrap(info[1].As<Napi::Object>())
+		: nullptr;
+	if (!memWrapper) {
+		JS_THROW("Argument 1 must be a CL Wrapper.");
+		return;
+	}
+	if (!info[2].IsNumber()) {
+		JS_THROW("Argument 2 must be of type `Number`");
+		return;
+	}
+	
+	cl_command_queue queue = queueWrapper->as<cl_command_queue>();
+	cl_mem mem = memWrapper->as<cl_mem>();
+	cl_map_flags flags = static_cast<cl_map_flags>(info[2].ToNumber().DoubleValue());
+	
+	bool isImage = info[3].IsArray();
+	if (isImage && !info[4].IsArray()) {
+		JS_THROW("Argument 4 must be of type `Array`");
+		return;
+	}
+	if (!isImage && !(info[3].IsNumber() && info[4].IsNumber())) {
+		JS_THROW("Arguments 3 and 4 must be of type `Number` or `Array`");
+		return;
+	}
+	
+	cl_int err = CL_SUCCESS;
+	void *ptr = nullptr;
+	size_t size = 0;
+	
+	if (isImage) {
+		size_t origin[] = { 0, 0, 0 };
+		size_t region[] = { 1, 1, 1 };
+		readImageCoords(info[3].As<Napi::Array>(), origin);
+		readImageCoords(info[4].As<Napi::Array>(), region);
+		
+		ptr = clEnqueueMapImage(
+			queue, mem, CL_TRUE, flags, origin, region,
+			&_rowPitch, &_slicePitch, 0, nullptr, nullptr, &err
+		);
+		
+		size = _slicePitch ? _slicePitch * region[2] : _rowPitch * region[1];
+	} else {
+		size_t offset = static_cast<size_t>(info[3].ToNumber().DoubleValue());
+		size = static_cast<size_t>(info[4].ToNumber().DoubleValue());
+		
+		ptr = clEnqueueMapBuffer(
+			queue, mem, CL_TRUE, flags, offset, size,
+			0, nullptr, nullptr, &err
+		);
+	}
+	
+	if (err != CL_SUCCESS) {
+		JS_THROW(getExceptionMessage(err));
+		return;
+	}
+	
+	clRetainCommandQueue(queue);
+	clRetainMemObject(mem);
+	_region = std::make_shared<Region>(Region { queue, mem, ptr, true });
+	
+	// The ArrayBuffer co-owns the region, so it is unmapped only when both the
+	// Mapping and all the views of the memory are gone
+	Napi::ArrayBuffer arrayBuffer = Napi::ArrayBuffer::New(
+		env, ptr, size, _bufferFinalized, new std::shared_ptr<Region>(_region)
+	);
+	_buffer.Reset(arrayBuffer, 1);
+}
+
+
+Mapping::~Mapping() {
+	_buffer.Reset();
+}
+
+
+Mapping::Region::~Region() {
+	clReleaseMemObject(mem);
+	clReleaseCommandQueue(queue);
+}
+
+
+void Mapping::_bufferFinalized(Napi::Env, void*, std::shared_ptr<Region> *hint) {
+	Region *region = hint->get();
+	if (region->isMapped) {
+		region->isMapped = false;
+		clEnqueueUnmapMemObject(region->queue, region->mem, region->ptr, 0, nullptr, nullptr);
+		clFlush(region->queue);
+	}
+	delete hint;
+}
+
+
+JS_IMPLEMENT_METHOD(Mapping, unmap) { NAPI_ENV;
+	if (!_region || !_region->isMapped) {
+		RET_UNDEFINED;
+	}
+	
+	GET_WAIT_LIST(0);
+	
+	CHECK_ERR(clEnqueueUnmapMemObject(
+		_region->queue,
+		_region->mem,
+		_region->ptr,
+		(cl_uint) cl_events.size(),
+		cl_events.empty() ? nullptr : cl_events.data(),
+		nullptr
+	));
+	_region->isMapped = false;
+	
+	// Any views of the unmapped memory become empty
+	_buffer.Value().As<Napi::ArrayBuffer>().Detach();
+	
+	RET_UNDEFINED;
+}
+
+
+JS_IMPLEMENT_GETTER(Mapping, buffer) { NAPI_ENV;
+	if (!_region || !_region->isMapped) {
+		RET_NULL;
+	}
+	RET_VALUE(_buffer.Value());
+}
+
+
+JS_IMPLEMENT_GETTER(Mapping, rowPitch) { NAPI_ENV;
+	RET_NUM(_rowPitch);
+}
+
+
+JS_IMPLEMENT_GETTER(Mapping, slicePitch) { NAPI_ENV;
+	RET_NUM(_slicePitch);
+}
+
+
+JS_IMPLEMENT_GETTER(Mapping, isMapped) { NAPI_ENV;
+	RET_BOOL(_region && _region->isMapped);
+}
+
+} // namespace opencl
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <memory>
+
+#include "wrapper.hpp"
+
+
+namespace opencl {
+
+// Owns a mapped region of a buffer or image. The ArrayBuffer is detached on
+// `unmap()`, and if it is collected while still mapped, the region is
+// unmapped asynchronously.
+class Mapping {
+DECLARE_ES5_CLASS(Mapping, Mapping);
+
+public:
+	static void init(Napi::Env env, Napi::Object exports);
+	
+	explicit Mapping(const Napi::CallbackInfo& info);
+	~Mapping();
+	
+	JS_DECLARE_METHOD(Mapping, unmap);
+	JS_DECLARE_GETTER(Mapping, buffer);
+	JS_DECLARE_GETTER(Mapping, rowPitch);
+	JS_DECLARE_GETTER(Mapping, slicePitch);
+	JS_DECLARE_GETTER(Mapping, isMapped);
+
+private:
+	// Shared with the ArrayBuffer finalizer, that may run after ~Mapping
+	struct Region {
+		cl_command_queue queue;
+		cl_mem mem;
+		void *ptr;
+		bool isMapped;
+		
+		~Region();
+	};
+	
+	std::shared_ptr<Region> _region;
+	Napi::ObjectReference _buffer;
+	size_t _rowPitch;
+	size_t _slicePitch;
+	
+	static void _bufferFinalized(Napi::Env env, void *data, std::shared_ptr<Region> *hint);
+};
+
+} // namespace opencl
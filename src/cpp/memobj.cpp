@@ -1,8 +1,85 @@
+#include <map>
+#include <mutex>
+#include <tuple>
+
 #include "wrapper.hpp"
+#include "keep-alive-helper.hpp"
 
 
 namespace opencl {
 
+// The smallest pooled buffer, the larger ones are powers of 2
+#define BUFFER_POOL_MIN_SIZE 256
+
+// Released pooled buffers, reused by the next request of the same class.
+// Trimmed down to `limit` bytes, least recently released first
+struct BufferPool {
+	typedef std::tuple<cl_context, cl_mem_flags, size_t> Key;
+	struct Entry {
+		cl_mem mem;
+		uint64_t stamp;
+	};
+	
+	std::mutex mutex;
+	std::multimap<Key, Entry> cached;
+	size_t cachedBytes = 0;
+	size_t limit = 256 * 1024 * 1024;
+	uint64_t stamp = 0;
+	uint64_t hits = 0;
+	uint64_t misses = 0;
+	
+	cl_mem take(const Key &key) {
+		std::lock_guard<std::mutex> lock(mutex);
+		auto it = cached.find(key);
+		if (it == cached.end()) {
+			misses++;
+			return nullptr;
+		}
+		hits++;
+		cl_mem mem = it->second.mem;
+		cachedBytes -= std::get<2>(key);
+		cached.erase(it);
+		return mem;
+	}
+	
+	void give(const Key &key, cl_mem mem) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			cached.insert({ key, { mem, ++stamp } });
+			cachedBytes += std::get<2>(key);
+		}
+		trim(limit);
+	}
+	
+	// Returns the number of bytes freed
+	size_t trim(size_t target) {
+		std::vector<cl_mem> evicted;
+		size_t freed = 0;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			while (cachedBytes > target) {
+				auto oldest = cached.begin();
+				for (auto it = cached.begin(); it != cached.end(); it++) {
+					if (it->second.stamp < oldest->second.stamp) {
+						oldest = it;
+					}
+				}
+				size_t capacity = std::get<2>(oldest->first);
+				cachedBytes -= capacity;
+				freed += capacity;
+				evicted.push_back(oldest->second.mem);
+				cached.erase(oldest);
+			}
+		}
+		for (cl_mem mem : evicted) {
+			clReleaseMemObject(mem);
+		}
+		return freed;
+	}
+};
+
+BufferPool bufferPool;
+
 JS_METHOD(createBuffer) { NAPI_ENV;
 	REQ_CL_ARG(0, context, cl_context);
 	REQ_OFFS_ARG(1, flags);
@@ -28,6 +105,15 @@ JS_METHOD(createBuffer) { NAPI_ENV;
 	cl_mem mem = clCreateBuffer(context, flags, size, host_ptr, &ret);
 	CHECK_ERR(ret);
 	
+	// The driver may access the host memory until the buffer is destroyed
+	if (flags & CL_MEM_USE_HOST_PTR) {
+		ret = KeepAliveHelper::untilDestroyed(env, mem, info[3]);
+		if (ret != CL_SUCCESS) {
+			clReleaseMemObject(mem);
+			THROW_ERR(ret);
+		}
+	}
+	
 	RET_WRAPPER(mem);
 }
 
@@ -123,10 +209,13 @@ JS_METHOD(createImage) { NAPI_ENV;
 	);
 	CHECK_ERR(ret);
 	
-	// if (host_ptr) {
-	//   NoCLAvoidGC* user_data = new NoCLAvoidGC(info[3].As<Object>());
-	//   clSetMemObjectDestructorCallback(mem, notifyFreeClMemObj, user_data);
-	// }
+	if (flags & CL_MEM_USE_HOST_PTR) {
+		ret = KeepAliveHelper::untilDestroyed(env, mem, info[4]);
+		if (ret != CL_SUCCESS) {
+			clReleaseMemObject(mem);
+			THROW_ERR(ret);
+		}
+	}
 	
 	RET_WRAPPER(mem);
 }
@@ -149,6 +238,107 @@ JS_METHOD(releaseMemObject) { NAPI_ENV;
 	RET_UNDEFINED;
 }
 
+JS_METHOD(createPooledBuffer) { NAPI_ENV;
+	REQ_CL_ARG(0, context, cl_context);
+	REQ_OFFS_ARG(1, flags);
+	REQ_OFFS_ARG(2, size);
+	
+	if (!flags) {
+		flags = CL_MEM_READ_WRITE;
+	}
+	if (flags & (CL_MEM_USE_HOST_PTR | CL_MEM_COPY_HOST_PTR)) {
+		THROW_ERR(CL_INVALID_VALUE);
+	}
+	if (!size) {
+		THROW_ERR(CL_INVALID_BUFFER_SIZE);
+	}
+	
+	size_t capacity = BUFFER_POOL_MIN_SIZE;
+	while (capacity < size) {
+		capacity <<= 1;
+	}
+	
+	BufferPool::Key key = { context, flags, capacity };
+	cl_mem mem = bufferPool.take(key);
+	if (mem) {
+		RET_WRAPPER(mem);
+	}
+	
+	cl_int ret;
+	mem = clCreateBuffer(context, flags, capacity, nullptr, &ret);
+	
+	// Out of device memory, the cached buffers are the first to go
+	if (ret == CL_MEM_OBJECT_ALLOCATION_FAILURE || ret == CL_OUT_OF_RESOURCES) {
+		if (bufferPool.trim(0)) {
+			mem = clCreateBuffer(context, flags, capacity, nullptr, &ret);
+		}
+	}
+	CHECK_ERR(ret);
+	
+	RET_WRAPPER(mem);
+}
+
+JS_METHOD(releasePooledBuffer) { NAPI_ENV;
+	REQ_WRAP_ARG(0, memWrapper);
+	cl_mem mem = memWrapper->as<cl_mem>();
+	
+	cl_context context = nullptr;
+	cl_mem_flags flags = 0;
+	size_t capacity = 0;
+	CHECK_ERR(clGetMemObjectInfo(mem, CL_MEM_CONTEXT, sizeof(cl_context), &context, nullptr));
+	CHECK_ERR(clGetMemObjectInfo(mem, CL_MEM_FLAGS, sizeof(cl_mem_flags), &flags, nullptr));
+	CHECK_ERR(clGetMemObjectInfo(mem, CL_MEM_SIZE, sizeof(size_t), &capacity, nullptr));
+	
+	// Not from the pool (e.g. a sub-buffer), such a buffer is just released
+	cl_mem parent = nullptr;
+	CHECK_ERR(clGetMemObjectInfo(
+		mem, CL_MEM_ASSOCIATED_MEMOBJECT, sizeof(cl_mem), &parent, nullptr
+	));
+	bool isPoolShaped = (
+		!parent &&
+		!(flags & (CL_MEM_USE_HOST_PTR | CL_MEM_COPY_HOST_PTR)) &&
+		capacity >= BUFFER_POOL_MIN_SIZE &&
+		!(capacity & (capacity - 1))
+	);
+	if (!isPoolShaped) {
+		CHECK_ERR(memWrapper->release());
+		RET_UNDEFINED;
+	}
+	
+	CHECK_ERR(memWrapper->detach());
+	bufferPool.give({ context, flags, capacity }, mem);
+	
+	RET_UNDEFINED;
+}
+
+JS_METHOD(trimBufferPool) { NAPI_ENV;
+	USE_OFFS_ARG(0, target, 0);
+	RET_NUM(bufferPool.trim(target));
+}
+
+JS_METHOD(setBufferPoolLimit) { NAPI_ENV;
+	REQ_OFFS_ARG(0, limit);
+	{
+		std::lock_guard<std::mutex> lock(bufferPool.mutex);
+		bufferPool.limit = limit;
+	}
+	bufferPool.trim(limit);
+	RET_UNDEFINED;
+}
+
+JS_METHOD(getBufferPoolStats) { NAPI_ENV;
+	std::lock_guard<std::mutex> lock(bufferPool.mutex);
+	
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("cachedBytes", JS_NUM(bufferPool.cachedBytes));
+	result.Set("cachedBuffers", JS_NUM(bufferPool.cached.size()));
+	result.Set("limit", JS_NUM(bufferPool.limit));
+	result.Set("hits", JS_NUM(static_cast<double>(bufferPool.hits)));
+	result.Set("misses", JS_NUM(static_cast<double>(bufferPool.misses)));
+	
+	RET_VALUE(result);
+}
+
 JS_METHOD(getSupportedImageFormats) { NAPI_ENV;
 	REQ_CL_ARG(0, context, cl_context);
 	REQ_OFFS_ARG(1, flags);
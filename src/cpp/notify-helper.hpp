@@ -50,7 +50,7 @@ private:
 			[that, resource](Napi::Env env, Napi::Function callback) {
 				callback.Call(
 					that->_ref.Value(),
-					{ Wrapper::from(env, resource), that->_ref.Get("data") }
+					{ Wrapper::fromBorrowed(env, resource), that->_ref.Get("data") }
 				);
 			}
 		);
@@ -67,7 +67,7 @@ private:
 			[that, resource, status](Napi::Env env, Napi::Function callback) {
 				callback.Call(
 					that->_ref.Value(),
-					{ Wrapper::from(env, resource), JS_NUM(status), that->_ref.Get("data") }
+					{ Wrapper::fromBorrowed(env, resource), JS_NUM(status), that->_ref.Get("data") }
 				);
 			}
 		);
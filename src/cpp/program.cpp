@@ -1,6 +1,7 @@
 #include <uv.h>
 
 #include "wrapper.hpp"
+#include "il.hpp"
 #include "notify-helper.hpp"
 
 
@@ -59,6 +60,62 @@ JS_METHOD(createProgramWithBinary) { NAPI_ENV;
 	RET_WRAPPER(p);
 }
 
+// The core function of OpenCL 2.1+, or the KHR extension of the context platform.
+// An ICD loader may export the core function for the platforms that don't have it
+static cl_program createProgramFromIL(
+	cl_context context, const void *il, size_t length, cl_int *ret
+) {
+	static CreateProgramWithILFn coreFn = reinterpret_cast<CreateProgramWithILFn>(
+		getClFunction("clCreateProgramWithIL")
+	);
+	if (coreFn) {
+		cl_program program = coreFn(context, il, length, ret);
+		if (*ret != CL_INVALID_OPERATION) {
+			return program;
+		}
+	}
+	
+	cl_device_id device = nullptr;
+	*ret = clGetContextInfo(
+		context, CL_CONTEXT_DEVICES, sizeof(cl_device_id), &device, nullptr
+	);
+	if (*ret != CL_SUCCESS) {
+		return nullptr;
+	}
+	cl_platform_id platform = nullptr;
+	*ret = clGetDeviceInfo(device, CL_DEVICE_PLATFORM, sizeof(cl_platform_id), &platform, nullptr);
+	if (*ret != CL_SUCCESS) {
+		return nullptr;
+	}
+	
+	CreateProgramWithILFn khrFn = reinterpret_cast<CreateProgramWithILFn>(
+		clGetExtensionFunctionAddressForPlatform(platform, "clCreateProgramWithILKHR")
+	);
+	if (!khrFn) {
+		*ret = CL_INVALID_OPERATION;
+		return nullptr;
+	}
+	return khrFn(context, il, length, ret);
+}
+
+JS_METHOD(createProgramWithIL) { NAPI_ENV;
+	REQ_CL_ARG(0, context, cl_context);
+	REQ_OBJ_ARG(1, js_il);
+	
+	void *il = nullptr;
+	size_t length = 0;
+	getPtrAndLen(js_il, &il, &length);
+	if (!il || !length) {
+		THROW_ERR(CL_INVALID_VALUE);
+	}
+	
+	cl_int ret = CL_SUCCESS;
+	cl_program p = createProgramFromIL(context, il, length, &ret);
+	CHECK_ERR(ret);
+	
+	RET_WRAPPER(p);
+}
+
 JS_METHOD(createProgramWithBuiltInKernels) { NAPI_ENV;
 	REQ_CL_ARG(0, context, cl_context);
 	REQ_ARRAY_ARG(1, js_devices);
@@ -163,6 +220,122 @@ JS_METHOD(buildProgram) { NAPI_ENV;
 	RET_UNDEFINED;
 }
 
+// Runs a blocking clBuildProgram on a libuv pool thread, so that several
+// programs build in parallel. On failure, the build logs are collected there too
+class BuildProgramWorker : public Napi::AsyncWorker {
+public:
+	BuildProgramWorker(
+		Napi::Env env, cl_program program,
+		std::vector<cl_device_id> devices, std::string options
+	):
+	Napi::AsyncWorker(env, "BuildProgramWorker"),
+	_deferred(Napi::Promise::Deferred::New(env)),
+	_program(program),
+	_devices(std::move(devices)),
+	_options(std::move(options)),
+	_err(CL_SUCCESS) {
+		clRetainProgram(_program);
+	}
+	
+	~BuildProgramWorker() {
+		clReleaseProgram(_program);
+	}
+	
+	Napi::Promise promise() {
+		return _deferred.Promise();
+	}
+
+protected:
+	void Execute() override {
+		_err = clBuildProgram(
+			_program,
+			(cl_uint) _devices.size(),
+			_devices.size() ? _devices.data() : nullptr,
+			_options.length() > 0 ? _options.c_str() : nullptr,
+			nullptr,
+			nullptr
+		);
+		if (_err == CL_SUCCESS) {
+			return;
+		}
+		
+		if (_devices.empty()) {
+			size_t size = 0;
+			clGetProgramInfo(_program, CL_PROGRAM_DEVICES, 0, nullptr, &size);
+			_devices.resize(size / sizeof(cl_device_id));
+			clGetProgramInfo(_program, CL_PROGRAM_DEVICES, size, _devices.data(), nullptr);
+		}
+		
+		for (cl_device_id device : _devices) {
+			size_t size = 0;
+			clGetProgramBuildInfo(_program, device, CL_PROGRAM_BUILD_LOG, 0, nullptr, &size);
+			std::string log(size, '\0');
+			clGetProgramBuildInfo(_program, device, CL_PROGRAM_BUILD_LOG, size, log.data(), nullptr);
+			// Drop the terminating null
+			if (!log.empty() && log.back() == '\0') {
+				log.pop_back();
+			}
+			_logs.push_back(log);
+		}
+	}
+	
+	void OnOK() override {
+		Napi::Env env = Env();
+		if (_err == CL_SUCCESS) {
+			_deferred.Resolve(env.Undefined());
+			return;
+		}
+		
+		Napi::Array logs = Napi::Array::New(env);
+		for (size_t i = 0; i < _logs.size(); i++) {
+			Napi::Object item = Napi::Object::New(env);
+			item.Set("device", Wrapper::from(env, _devices[i]));
+			item.Set("log", JS_STR(_logs[i]));
+			logs.Set(static_cast<uint32_t>(i), item);
+		}
+		
+		Napi::Object error = Napi::Error::New(env, getExceptionMessage(_err)).Value();
+		error.Set("code", JS_NUM(_err));
+		error.Set("logs", logs);
+		_deferred.Reject(error);
+	}
+
+private:
+	Napi::Promise::Deferred _deferred;
+	cl_program _program;
+	std::vector<cl_device_id> _devices;
+	std::string _options;
+	cl_int _err;
+	std::vector<std::string> _logs;
+};
+
+JS_METHOD(buildProgramAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, p, cl_program);
+	
+	std::vector<cl_device_id> cl_devices;
+	if (!IS_ARG_EMPTY(1)) {
+		REQ_ARRAY_ARG(1, js_devices);
+		if (Wrapper::fromJsArray(js_devices, &cl_devices)) {
+			RET_UNDEFINED;
+		}
+	}
+	
+	std::string options;
+	if (!IS_ARG_EMPTY(2)) {
+		REQ_STR_ARG(2, str);
+		options = str;
+	}
+	
+	// The worker deletes itself after OnOK
+	BuildProgramWorker *worker = new BuildProgramWorker(
+		env, p, std::move(cl_devices), std::move(options)
+	);
+	Napi::Promise promise = worker->promise();
+	worker->Queue();
+	
+	RET_VALUE(promise);
+}
+
 JS_METHOD(compileProgram) { NAPI_ENV;
 	REQ_CL_ARG(0, p, cl_program);
 	
@@ -431,10 +604,11 @@ JS_METHOD(getProgramInfo) { NAPI_ENV;
 				nullptr
 			));
 			
+			// The binaries are copied, as the CL-side copies are deleted below
 			Napi::Array arr = Napi::Array::New(env);
 			for (cl_uint i = 0; i < nsizes; i++) {
-				void* data = reinterpret_cast<void*>(bn[i]);
-				Napi::ArrayBuffer buf = Napi::ArrayBuffer::New(env, data, sizes[i]);
+				Napi::ArrayBuffer buf = Napi::ArrayBuffer::New(env, sizes[i]);
+				memcpy(buf.Data(), bn[i], sizes[i]);
 				arr.Set(i, buf);
 			}
 			
@@ -464,6 +638,19 @@ JS_METHOD(getProgramInfo) { NAPI_ENV;
 			));
 			RET_STR(names.get());
 		}
+		case CL_PROGRAM_IL: {
+			size_t size = 0;
+			cl_int err = clGetProgramInfo(prog, param_name, 0, nullptr, &size);
+			// Programs from source or binaries have no IL, and neither has
+			// any program of a 1.2 platform, where the query is invalid
+			if (err == CL_INVALID_VALUE || (err == CL_SUCCESS && !size)) {
+				RET_NULL;
+			}
+			CHECK_ERR(err);
+			Napi::ArrayBuffer buf = Napi::ArrayBuffer::New(env, size);
+			CHECK_ERR(clGetProgramInfo(prog, param_name, size, buf.Data(), nullptr));
+			RET_VALUE(buf);
+		}
 	}
 	
 	THROW_ERR(CL_INVALID_VALUE);
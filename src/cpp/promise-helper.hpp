@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+
+#include "wrapper.hpp"
+
+namespace opencl {
+
+// Settles a Promise when all watched events reach CL_COMPLETE.
+// Event callbacks fire on driver threads, the settlement is marshalled to
+// the JS thread via TSFN. The helper deletes itself through TSFN finalizer.
+class PromiseHelper {
+public:
+	PromiseHelper(Napi::Env env, Napi::Value result, Napi::Value keepAlive):
+	_deferred(Napi::Promise::Deferred::New(env)), _pending(1), _status(CL_COMPLETE),
+	_mapQueue(nullptr), _mapMem(nullptr), _mapPtr(nullptr) {
+		_ref.Reset(Napi::Object::New(env), 1);
+		_ref.Set("result", result);
+		_ref.Set("keep", keepAlive);
+		
+		void *context = nullptr;
+		_tsfn = Napi::ThreadSafeFunction::New(
+			env, Napi::Function(), "PromiseHelper", 0LLU, 1LLU, context, _delete, this
+		);
+	}
+	
+	~PromiseHelper() {
+		if (_mapQueue) {
+			clReleaseMemObject(_mapMem);
+			clReleaseCommandQueue(_mapQueue);
+		}
+		
+		Napi::Env env = _ref.Env();
+		_ref.Set("result", JS_NULL);
+		_ref.Set("keep", JS_NULL);
+		_ref.Reset();
+	}
+	
+	// The event is released on the JS thread once the Promise settles
+	void own(cl_event event) {
+		_owned.push_back(event);
+	}
+	
+	// The mapped region is unmapped if the Promise is rejected, as no one gets it
+	void unmapOnReject(cl_command_queue queue, cl_mem mem, void *ptr) {
+		clRetainCommandQueue(queue);
+		clRetainMemObject(mem);
+		_mapQueue = queue;
+		_mapMem = mem;
+		_mapPtr = ptr;
+	}
+	
+	cl_int watch(cl_event event) {
+		_pending++;
+		cl_int err = clSetEventCallback(event, CL_COMPLETE, _callNotify, this);
+		if (err != CL_SUCCESS) {
+			_done(err);
+		}
+		return err;
+	}
+	
+	// Stop watching new events. The helper must not be touched afterwards
+	Napi::Promise start() {
+		Napi::Promise promise = _deferred.Promise();
+		_done(CL_COMPLETE);
+		return promise;
+	}
+	
+	// Shortcut for a single event that was created for this Promise only
+	static Napi::Promise fromEvent(
+		Napi::Env env, cl_event event, Napi::Value result, Napi::Value keepAlive
+	) {
+		PromiseHelper *helper = new PromiseHelper(env, result, keepAlive);
+		helper->own(event);
+		helper->watch(event);
+		return helper->start();
+	}
+	
+	// Shortcut for a non-blocking map
+	static Napi::Promise fromMapEvent(
+		Napi::Env env, cl_event event, Napi::Value result,
+		cl_command_queue queue, cl_mem mem, void *ptr
+	) {
+		PromiseHelper *helper = new PromiseHelper(env, result, env.Undefined());
+		helper->unmapOnReject(queue, mem, ptr);
+		helper->own(event);
+		helper->watch(event);
+		return helper->start();
+	}
+
+private:
+	Napi::Promise::Deferred _deferred;
+	Napi::ObjectReference _ref;
+	Napi::ThreadSafeFunction _tsfn;
+	std::vector<cl_event> _owned;
+	std::atomic<int> _pending;
+	std::atomic<cl_int> _status;
+	cl_command_queue _mapQueue;
+	cl_mem _mapMem;
+	void *_mapPtr;
+	
+	static void _delete(napi_env env, PromiseHelper* that, void*) {
+		delete that;
+	}
+	
+	static void CL_CALLBACK _callNotify(cl_event, cl_int status, void *ptr) {
+		PromiseHelper *helper = reinterpret_cast<PromiseHelper*>(ptr);
+		helper->_done(status);
+	}
+	
+	void _done(cl_int status) {
+		if (status < 0) {
+			cl_int expected = CL_COMPLETE;
+			_status.compare_exchange_strong(expected, status);
+		}
+		
+		if (--_pending > 0) {
+			return;
+		}
+		
+		PromiseHelper *that = this;
+		napi_status result = _tsfn.NonBlockingCall(
+			[that](Napi::Env env, Napi::Function) {
+				that->_settle(env);
+			}
+		);
+		if (result != napi_ok) {
+			fprintf(stderr, "Error: can't call TSFN (#%d).\n", result);
+		}
+		
+		_tsfn.Release();
+	}
+	
+	void _settle(Napi::Env env) {
+		for (cl_event event : _owned) {
+			clReleaseEvent(event);
+		}
+		_owned.clear();
+		
+		cl_int status = _status;
+		if (status == CL_COMPLETE) {
+			_deferred.Resolve(_ref.Get("result"));
+		} else {
+			if (_mapQueue) {
+				clEnqueueUnmapMemObject(_mapQueue, _mapMem, _mapPtr, 0, nullptr, nullptr);
+				clFlush(_mapQueue);
+			}
+			_deferred.Reject(Napi::Error::New(env, getExceptionMessage(status)).Value());
+		}
+	}
+};
+
+} // namespace opencl
@@ -1,12 +1,16 @@
 #include <algorithm>
 
 #include "wrapper.hpp"
+#include "promise-helper.hpp"
+#include "keep-alive-helper.hpp"
+#include "svm.hpp"
 
 
 namespace opencl {
 
 #define GET_EVENT_FLAG(n)                                                     \
 	cl_event event = nullptr;                                                 \
+	bool isEventHandle = IS_EVENT_HANDLE_FLAG(n);                             \
 	cl_event* eventPtr =                                                      \
 		(!IS_ARG_EMPTY(n) && info[n].ToBoolean().Value())                     \
 		? &event : nullptr;
@@ -21,13 +25,88 @@ namespace opencl {
 	GET_WAIT_LIST(n);                                                         \
 	GET_EVENT_FLAG(n + 1);
 
+// Non-blocking transfers need an event to keep the host memory alive
+#define GET_TRANSFER_EVENT(BLOCKING)                                          \
+	cl_event transferEvent = nullptr;                                         \
+	cl_event *transferEventPtr =                                              \
+		((BLOCKING) || eventPtr) ? eventPtr : &transferEvent;
+
+#define KEEP_HOST_ALIVE(BLOCKING, HOST)                                       \
+	if (!(BLOCKING)) {                                                        \
+		keepHostAlive(env, transferEvent ? transferEvent : event, HOST);      \
+		if (transferEvent) {                                                  \
+			clReleaseEvent(transferEvent);                                    \
+		}                                                                     \
+	}
+
+// A kernel launch keeps the SVM memory of its args alive, the same way
+#define GET_SVM_LAUNCH_EVENT(KERNEL_WRAPPER)                                  \
+	Napi::Value svmRefs = (KERNEL_WRAPPER)->copySvmRefs(env);                 \
+	bool hasNoSvm = svmRefs.IsUndefined();                                    \
+	GET_TRANSFER_EVENT(hasNoSvm);
+
+#define GET_HOST_PTR_AS(HOST, PTR, LEN)                                       \
+	void *PTR = nullptr;                                                      \
+	size_t LEN = 0;                                                           \
+	getPtrAndLen(HOST, &PTR, &LEN);                                           \
+	if (!PTR || !LEN) {                                                       \
+		JS_THROW("Could not read buffer data.");                              \
+		RET_UNDEFINED;                                                        \
+	}
+
+#define GET_HOST_PTR(HOST) GET_HOST_PTR_AS(HOST, ptr, len)
+
 #define RET_EVENT                                                             \
 	if (eventPtr) {                                                           \
+		if (isEventHandle) {                                                  \
+			RET_EVENT_HANDLE(event);                                          \
+		}                                                                     \
 		RET_WRAPPER(event);                                                   \
 	} else {                                                                  \
 		RET_UNDEFINED;                                                  \
 	}
 
+// Submits the queue, then settles with RESULT when `event` completes
+#define RET_PROMISE(RESULT, KEEP)                                             \
+	{                                                                         \
+		cl_int _flushErr = clFlush(clQueue);                                  \
+		if (_flushErr != CL_SUCCESS) {                                        \
+			clReleaseEvent(event);                                            \
+			THROW_ERR(_flushErr);                                             \
+		}                                                                     \
+		RET_VALUE(PromiseHelper::fromEvent(env, event, RESULT, KEEP));        \
+	}
+
+
+// Reads up to 3 components of an image origin/region, or a rect offset
+void readImageCoords(Napi::Array arr, size_t *coords) {
+	uint32_t count = std::min(arr.Length(), 3u);
+	for (uint32_t i = 0; i < count; i++) {
+		coords[i] = static_cast<size_t>(arr.Get(i).ToNumber().Int64Value());
+	}
+}
+
+// Like RET_PROMISE, but a rejected map is unmapped, as no one gets the memory
+#define RET_MAP_PROMISE(RESULT)                                               \
+	{                                                                         \
+		cl_int _flushErr = clFlush(clQueue);                                  \
+		if (_flushErr != CL_SUCCESS) {                                        \
+			clReleaseEvent(event);                                            \
+			clEnqueueUnmapMemObject(clQueue, mem, mPtr, 0, nullptr, nullptr); \
+			THROW_ERR(_flushErr);                                             \
+		}                                                                     \
+		RET_VALUE(PromiseHelper::fromMapEvent(                                \
+			env, event, RESULT, clQueue, mem, mPtr                            \
+		));                                                                   \
+	}
+
+// The host memory stays referenced until the transfer is complete. If that
+// can't be tracked, the transfer is waited for right away
+void keepHostAlive(Napi::Env env, cl_event event, Napi::Value host) {
+	if (KeepAliveHelper::untilComplete(env, event, host) != CL_SUCCESS) {
+		clWaitForEvents(1, &event);
+	}
+}
 
 JS_METHOD(createCommandQueue) { NAPI_ENV;
 	REQ_CL_ARG(0, context, cl_context);
@@ -132,6 +211,16 @@ JS_METHOD(finish) { NAPI_ENV;
 	RET_NUM(err);
 }
 
+JS_METHOD(finishAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	
+	// A marker without a wait list completes after all previous commands
+	cl_event event = nullptr;
+	CHECK_ERR(clEnqueueMarkerWithWaitList(clQueue, 0, nullptr, &event));
+	
+	RET_PROMISE(env.Undefined(), env.Undefined());
+}
+
 JS_METHOD(enqueueReadBuffer) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, clMem, cl_mem);
@@ -140,15 +229,10 @@ JS_METHOD(enqueueReadBuffer) { NAPI_ENV;
 	REQ_OFFS_ARG(4, size);
 	REQ_OBJ_ARG(5, buffer);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	GET_WAIT_LIST_AND_EVENT(6);
+	GET_TRANSFER_EVENT(blocking_read);
 	
 	CHECK_ERR(clEnqueueReadBuffer(
 		clQueue,
@@ -159,12 +243,40 @@ JS_METHOD(enqueueReadBuffer) { NAPI_ENV;
 		ptr,
 		(cl_uint) cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
+	KEEP_HOST_ALIVE(blocking_read, buffer);
 	
 	RET_EVENT;
 }
 
+JS_METHOD(enqueueReadBufferAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_CL_ARG(1, clMem, cl_mem);
+	REQ_OFFS_ARG(2, offset);
+	REQ_OFFS_ARG(3, size);
+	REQ_OBJ_ARG(4, buffer);
+	
+	GET_HOST_PTR(buffer);
+	
+	GET_WAIT_LIST(5);
+	cl_event event = nullptr;
+	
+	CHECK_ERR(clEnqueueReadBuffer(
+		clQueue,
+		clMem,
+		CL_FALSE,
+		offset,
+		size,
+		ptr,
+		(cl_uint) cl_events.size(),
+		&cl_events.front(),
+		&event
+	));
+	
+	RET_PROMISE(buffer, buffer);
+}
+
 JS_METHOD(enqueueReadBufferRect) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, clMem, cl_mem);
@@ -178,33 +290,18 @@ JS_METHOD(enqueueReadBufferRect) { NAPI_ENV;
 	REQ_OFFS_ARG(9, host_slice_pitch);
 	REQ_OBJ_ARG(10, buffer);
 	
-	size_t bufferOffsetArrayLen = std::max(bufferOffsetArray.Length(), 2u);
-	size_t hostOffsetArrayLen = std::max(hostOffsetArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t buffer_offset[] = { 0, 0, 0 };
 	size_t host_offset[] = { 0, 0, 0 };
 	size_t region[] = { 1, 1, 1 };
 	
-	for(size_t i = 0; i < bufferOffsetArrayLen; i++) {
-		buffer_offset[i] = bufferOffsetArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < hostOffsetArrayLen; i++) {
-		host_offset[i] = hostOffsetArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(bufferOffsetArray, buffer_offset);
+	readImageCoords(hostOffsetArray, host_offset);
+	readImageCoords(regionArray, region);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	GET_WAIT_LIST_AND_EVENT(11)
+	GET_TRANSFER_EVENT(blocking_read);
 	
 	CHECK_ERR(clEnqueueReadBufferRect(
 		clQueue,
@@ -219,8 +316,9 @@ JS_METHOD(enqueueReadBufferRect) { NAPI_ENV;
 		host_slice_pitch, ptr,
 		(cl_uint)cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
+	KEEP_HOST_ALIVE(blocking_read, buffer);
 	
 	RET_EVENT;
 }
@@ -233,16 +331,10 @@ JS_METHOD(enqueueWriteBuffer) { NAPI_ENV;
 	REQ_OFFS_ARG(4, size);
 	REQ_OBJ_ARG(5, buffer);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	GET_WAIT_LIST_AND_EVENT(6);
+	GET_TRANSFER_EVENT(blocking_write);
 	
 	CHECK_ERR(clEnqueueWriteBuffer(
 		clQueue,
@@ -253,12 +345,40 @@ JS_METHOD(enqueueWriteBuffer) { NAPI_ENV;
 		ptr,
 		(cl_uint)cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
+	KEEP_HOST_ALIVE(blocking_write, buffer);
 	
 	RET_EVENT;
 }
 
+JS_METHOD(enqueueWriteBufferAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_CL_ARG(1, clMem, cl_mem);
+	REQ_OFFS_ARG(2, offset);
+	REQ_OFFS_ARG(3, size);
+	REQ_OBJ_ARG(4, buffer);
+	
+	GET_HOST_PTR(buffer);
+	
+	GET_WAIT_LIST(5);
+	cl_event event = nullptr;
+	
+	CHECK_ERR(clEnqueueWriteBuffer(
+		clQueue,
+		clMem,
+		CL_FALSE,
+		offset,
+		size,
+		ptr,
+		(cl_uint)cl_events.size(),
+		&cl_events.front(),
+		&event
+	));
+	
+	RET_PROMISE(env.Undefined(), buffer);
+}
+
 JS_METHOD(enqueueWriteBufferRect) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, clMem, cl_mem);
@@ -272,33 +392,18 @@ JS_METHOD(enqueueWriteBufferRect) { NAPI_ENV;
 	REQ_OFFS_ARG(9, host_slice_pitch);
 	REQ_OBJ_ARG(10, buffer);
 	
-	size_t bufferOffsetArrayLen = std::max(bufferOffsetArray.Length(), 2u);
-	size_t hostOffsetArrayLen = std::max(hostOffsetArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t buffer_offset[] = { 0, 0, 0 };
 	size_t host_offset[] = { 0, 0, 0 };
 	size_t region[] = { 1, 1, 1 };
 	
-	for(size_t i = 0; i < bufferOffsetArrayLen; i++) {
-		buffer_offset[i] = bufferOffsetArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < hostOffsetArrayLen; i++) {
-		host_offset[i] = hostOffsetArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(bufferOffsetArray, buffer_offset);
+	readImageCoords(hostOffsetArray, host_offset);
+	readImageCoords(regionArray, region);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	GET_WAIT_LIST_AND_EVENT(11);
+	GET_TRANSFER_EVENT(blocking_write);
 	
 	CHECK_ERR(clEnqueueWriteBufferRect(
 		clQueue,
@@ -314,8 +419,9 @@ JS_METHOD(enqueueWriteBufferRect) { NAPI_ENV;
 		ptr,
 		(cl_uint)cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
+	KEEP_HOST_ALIVE(blocking_write, buffer);
 	
 	RET_EVENT;
 }
@@ -397,22 +503,13 @@ JS_METHOD(enqueueCopyBufferRect) { NAPI_ENV;
 	REQ_OFFS_ARG(8, dst_row_pitch);
 	REQ_OFFS_ARG(9, dst_slice_pitch);
 	
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t destOriginArrayLen = std::max(destOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t src_origin[] = { 0, 0, 0 };
 	size_t dst_origin[] = { 0, 0, 0 };
 	size_t region[] = { 1, 1, 1 };
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		src_origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < destOriginArrayLen; i++) {
-		dst_origin[i] = destOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, src_origin);
+	readImageCoords(destOriginArray, dst_origin);
+	readImageCoords(regionArray, region);
 	
 	GET_WAIT_LIST_AND_EVENT(10);
 	
@@ -445,28 +542,16 @@ JS_METHOD(enqueueReadImage) { NAPI_ENV;
 	REQ_OFFS_ARG(6, slice_pitch);
 	REQ_OBJ_ARG(7, buffer);
 	
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t origin[] = {0, 0, 0};
 	size_t region[] = {1, 1, 1};
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	GET_WAIT_LIST_AND_EVENT(8);
+	GET_TRANSFER_EVENT(blocking_read);
 	
 	CHECK_ERR(clEnqueueReadImage(
 		clQueue,
@@ -479,12 +564,50 @@ JS_METHOD(enqueueReadImage) { NAPI_ENV;
 		ptr,
 		(cl_uint)cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
+	KEEP_HOST_ALIVE(blocking_read, buffer);
 	
 	RET_EVENT;
 }
 
+JS_METHOD(enqueueReadImageAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_CL_ARG(1, image, cl_mem);
+	REQ_ARRAY_ARG(2, srcOriginArray);
+	REQ_ARRAY_ARG(3, regionArray);
+	REQ_OFFS_ARG(4, row_pitch);
+	REQ_OFFS_ARG(5, slice_pitch);
+	REQ_OBJ_ARG(6, buffer);
+	
+	size_t origin[] = {0, 0, 0};
+	size_t region[] = {1, 1, 1};
+	
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
+	
+	GET_HOST_PTR(buffer);
+	
+	GET_WAIT_LIST(7);
+	cl_event event = nullptr;
+	
+	CHECK_ERR(clEnqueueReadImage(
+		clQueue,
+		image,
+		CL_FALSE,
+		origin,
+		region,
+		row_pitch,
+		slice_pitch,
+		ptr,
+		(cl_uint)cl_events.size(),
+		&cl_events.front(),
+		&event
+	));
+	
+	RET_PROMISE(buffer, buffer);
+}
+
 JS_METHOD(enqueueWriteImage) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, image, cl_mem);
@@ -495,28 +618,16 @@ JS_METHOD(enqueueWriteImage) { NAPI_ENV;
 	REQ_OFFS_ARG(6, slice_pitch);
 	REQ_OBJ_ARG(7, buffer);
 	
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t origin[] = {0, 0, 0};
 	size_t region[] = {1, 1, 1};
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	GET_WAIT_LIST_AND_EVENT(8);
+	GET_TRANSFER_EVENT(blocking_write);
 	
 	CHECK_ERR(clEnqueueWriteImage(
 		clQueue,
@@ -529,12 +640,50 @@ JS_METHOD(enqueueWriteImage) { NAPI_ENV;
 		ptr,
 		(cl_uint)cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
+	KEEP_HOST_ALIVE(blocking_write, buffer);
 	
 	RET_EVENT;
 }
 
+JS_METHOD(enqueueWriteImageAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_CL_ARG(1, image, cl_mem);
+	REQ_ARRAY_ARG(2, srcOriginArray);
+	REQ_ARRAY_ARG(3, regionArray);
+	REQ_OFFS_ARG(4, row_pitch);
+	REQ_OFFS_ARG(5, slice_pitch);
+	REQ_OBJ_ARG(6, buffer);
+	
+	size_t origin[] = {0, 0, 0};
+	size_t region[] = {1, 1, 1};
+	
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
+	
+	GET_HOST_PTR(buffer);
+	
+	GET_WAIT_LIST(7);
+	cl_event event = nullptr;
+	
+	CHECK_ERR(clEnqueueWriteImage(
+		clQueue,
+		image,
+		CL_FALSE,
+		origin,
+		region,
+		row_pitch,
+		slice_pitch,
+		ptr,
+		(cl_uint)cl_events.size(),
+		&cl_events.front(),
+		&event
+	));
+	
+	RET_PROMISE(env.Undefined(), buffer);
+}
+
 JS_METHOD(enqueueFillImage) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, image, cl_mem);
@@ -542,26 +691,13 @@ JS_METHOD(enqueueFillImage) { NAPI_ENV;
 	REQ_ARRAY_ARG(3, srcOriginArray);
 	REQ_ARRAY_ARG(4, regionArray);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
-	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
-	}
+	GET_HOST_PTR(buffer);
 	
 	size_t origin[] = {0, 0, 0};
 	size_t region[] = {1, 1, 1};
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
 	
 	GET_WAIT_LIST_AND_EVENT(5);
 	
@@ -587,22 +723,13 @@ JS_METHOD(enqueueCopyImage) { NAPI_ENV;
 	REQ_ARRAY_ARG(4, destOriginArray);
 	REQ_ARRAY_ARG(5, regionArray);
 	
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t destOriginArrayLen = std::max(destOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t src_origin[] = { 0, 0, 0 };
 	size_t dst_origin[] = { 0, 0, 0 };
 	size_t region[] = { 1, 1, 1 };
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		src_origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < destOriginArrayLen; i++) {
-		dst_origin[i] = destOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, src_origin);
+	readImageCoords(destOriginArray, dst_origin);
+	readImageCoords(regionArray, region);
 	
 	GET_WAIT_LIST_AND_EVENT(6);
 	
@@ -629,17 +756,11 @@ JS_METHOD(enqueueCopyImageToBuffer) { NAPI_ENV;
 	REQ_ARRAY_ARG(4, regionArray);
 	REQ_OFFS_ARG(5, dst_offset);
 	
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	size_t src_origin[] = { 0, 0, 0 };
 	size_t region[] = { 1, 1, 1 };
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		src_origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, src_origin);
+	readImageCoords(regionArray, region);
 	
 	GET_WAIT_LIST_AND_EVENT(6);
 	
@@ -668,15 +789,9 @@ JS_METHOD(enqueueCopyBufferToImage) { NAPI_ENV;
 
 	size_t dst_origin[] = {0, 0, 0};
 	size_t region[] = {1, 1, 1};
-	size_t dstOriginArrayLen = std::max(dstOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	
-	for(size_t i = 0; i < dstOriginArrayLen; i++) {
-		dst_origin[i] = dstOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(dstOriginArray, dst_origin);
+	readImageCoords(regionArray, region);
 	
 	GET_WAIT_LIST_AND_EVENT(6);
 	
@@ -733,6 +848,39 @@ JS_METHOD(enqueueMapBuffer) { NAPI_ENV;
 	RET_VALUE(result);
 }
 
+JS_METHOD(enqueueMapBufferAsync) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_CL_ARG(1, mem, cl_mem);
+	REQ_OFFS_ARG(2, map_flags);
+	REQ_OFFS_ARG(3, offset);
+	REQ_OFFS_ARG(4, size);
+	GET_WAIT_LIST(5);
+	
+	cl_event event = nullptr;
+	void* mPtr = nullptr;
+	cl_int err;
+	
+	mPtr = clEnqueueMapBuffer(
+		clQueue,
+		mem,
+		CL_FALSE,
+		map_flags,
+		offset,
+		size,
+		(cl_uint)cl_events.size(),
+		&cl_events.front(),
+		&event,
+		&err
+	);
+	
+	CHECK_ERR(err);
+	
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("buffer", Napi::ArrayBuffer::New(env, mPtr, size));
+	
+	RET_MAP_PROMISE(result);
+}
+
 JS_METHOD(enqueueMapImage) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, mem, cl_mem);
@@ -744,15 +892,9 @@ JS_METHOD(enqueueMapImage) { NAPI_ENV;
 	
 	size_t origin[] = {0, 0, 0};
 	size_t region[] = {1, 1, 1};
-	size_t srcOriginArrayLen = std::max(srcOriginArray.Length(), 2u);
-	size_t regionArrayLen = std::max(regionArray.Length(), 2u);
 	
-	for(size_t i = 0; i < srcOriginArrayLen; i++) {
-		origin[i] = srcOriginArray.Get(i).ToNumber().Int64Value();
-	}
-	for(size_t i = 0; i < regionArrayLen; i++) {
-		region[i] = regionArray.Get(i).ToNumber().Int64Value();
-	}
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
 	
 	size_t image_row_pitch;
 	size_t image_slice_pitch;
@@ -796,20 +938,64 @@ JS_METHOD(enqueueMapImage) { NAPI_ENV;
 	RET_VALUE(result);
 }
 
-JS_METHOD(enqueueUnmapMemObject) { NAPI_ENV;
+JS_METHOD(enqueueMapImageAsync) { NAPI_ENV;
 	REQ_CL_ARG(0, clQueue, cl_command_queue);
 	REQ_CL_ARG(1, mem, cl_mem);
-	REQ_OBJ_ARG(2, buffer);
+	REQ_OFFS_ARG(2, map_flags);
+	REQ_ARRAY_ARG(3, srcOriginArray);
+	REQ_ARRAY_ARG(4, regionArray);
+	GET_WAIT_LIST(5);
 	
-	void *ptr = nullptr;
-	size_t len = 0;
-	getPtrAndLen(buffer, &ptr, &len);
+	size_t origin[] = {0, 0, 0};
+	size_t region[] = {1, 1, 1};
 	
-	if (!ptr || !len) {
-		JS_THROW("Could not read buffer data.");
-		RET_UNDEFINED;
+	readImageCoords(srcOriginArray, origin);
+	readImageCoords(regionArray, region);
+	
+	size_t image_row_pitch;
+	size_t image_slice_pitch;
+	
+	cl_event event = nullptr;
+	void* mPtr = nullptr;
+	cl_int err;
+	
+	mPtr = clEnqueueMapImage(
+		clQueue,
+		mem,
+		CL_FALSE,
+		map_flags,
+		origin,
+		region,
+		&image_row_pitch,
+		&image_slice_pitch,
+		(cl_uint)cl_events.size(),
+		&cl_events.front(),
+		&event,
+		&err
+	);
+	
+	CHECK_ERR(err)
+	
+	size_t size = image_row_pitch * region[1];
+	if (image_slice_pitch) {
+		size = image_slice_pitch * region[2];
 	}
 	
+	Napi::Object result = Napi::Object::New(env);
+	result.Set("buffer", Napi::ArrayBuffer::New(env, mPtr, size));
+	result.Set("image_row_pitch", JS_NUM(image_row_pitch));
+	result.Set("image_slice_pitch", JS_NUM(image_slice_pitch));
+	
+	RET_MAP_PROMISE(result);
+}
+
+JS_METHOD(enqueueUnmapMemObject) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_CL_ARG(1, mem, cl_mem);
+	REQ_OBJ_ARG(2, buffer);
+	
+	GET_HOST_PTR(buffer);
+	
 	GET_WAIT_LIST_AND_EVENT(3);
 	
 	cl_int err;
@@ -903,6 +1089,7 @@ JS_METHOD(enqueueNDRangeKernel) { NAPI_ENV;
 	}
 	
 	GET_WAIT_LIST_AND_EVENT(6);
+	GET_SVM_LAUNCH_EVENT(_wrap_k);
 	
 	CHECK_ERR(clEnqueueNDRangeKernel(
 		clQueue,
@@ -913,9 +1100,86 @@ JS_METHOD(enqueueNDRangeKernel) { NAPI_ENV;
 		cl_work_local.size() ? cl_work_local.data() : nullptr,
 		(cl_uint)cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
+	));
+	
+	KEEP_HOST_ALIVE(hasNoSvm, svmRefs);
+	RET_EVENT;
+}
+
+// Negative sizes would wrap to huge size_t values, so they are malformed too
+static bool readWorkSize(Napi::Value value, size_t *out) {
+	if (!value.IsNumber()) {
+		return false;
+	}
+	int64_t size = value.ToNumber().Int64Value();
+	if (size < 0) {
+		return false;
+	}
+	*out = static_cast<size_t>(size);
+	return true;
+}
+
+cl_uint readWorkSizes(Napi::Value value, size_t *out) {
+	if (value.IsNumber()) {
+		return readWorkSize(value, out) ? 1 : 0;
+	}
+	if (!value.IsArray()) {
+		return 0;
+	}
+	Napi::Array arr = value.As<Napi::Array>();
+	cl_uint count = arr.Length();
+	if (count < 1 || count > 3) {
+		return 0;
+	}
+	for (cl_uint i = 0; i < count; i++) {
+		if (!readWorkSize(arr.Get(i), &out[i])) {
+			return 0;
+		}
+	}
+	return count;
+}
+
+JS_METHOD(dispatch) { NAPI_ENV;
+	REQ_CL_ARG(0, clQueue, cl_command_queue);
+	REQ_WRAP_ARG(1, kernelWrapper);
+	
+	if (!IS_ARG_EMPTY(2)) {
+		REQ_ARRAY_ARG(2, args);
+		if (!bindKernelArgs(env, kernelWrapper, args, env.Undefined())) {
+			RET_UNDEFINED;
+		}
+	}
+	
+	size_t work_global[3] = { 1, 1, 1 };
+	size_t work_local[3] = { 1, 1, 1 };
+	
+	cl_uint work_dim = readWorkSizes(info[3], work_global);
+	if (!work_dim) {
+		THROW_ERR(CL_INVALID_GLOBAL_WORK_SIZE);
+	}
+	
+	bool hasLocal = !IS_ARG_EMPTY(4);
+	if (hasLocal && readWorkSizes(info[4], work_local) != work_dim) {
+		THROW_ERR(CL_INVALID_WORK_GROUP_SIZE);
+	}
+	
+	GET_WAIT_LIST_AND_EVENT(5);
+	GET_SVM_LAUNCH_EVENT(kernelWrapper);
+	
+	CHECK_ERR(clEnqueueNDRangeKernel(
+		clQueue,
+		kernelWrapper->as<cl_kernel>(),
+		work_dim,
+		nullptr,
+		work_global,
+		hasLocal ? work_local : nullptr,
+		(cl_uint)cl_events.size(),
+		cl_events.data(),
+		transferEventPtr
 	));
 	
+	KEEP_HOST_ALIVE(hasNoSvm, svmRefs);
 	RET_EVENT;
 }
 
@@ -924,15 +1188,17 @@ JS_METHOD(enqueueTask) { NAPI_ENV;
 	REQ_CL_ARG(1, k, cl_kernel);
 	
 	GET_WAIT_LIST_AND_EVENT(2);
+	GET_SVM_LAUNCH_EVENT(_wrap_k);
 	
 	CHECK_ERR(clEnqueueTask(
 		clQueue,
 		k,
 		cl_events.size(),
 		&cl_events.front(),
-		eventPtr
+		transferEventPtr
 	));
 	
+	KEEP_HOST_ALIVE(hasNoSvm, svmRefs);
 	RET_EVENT;
 }
 
@@ -960,6 +1226,7 @@ JS_METHOD(enqueueMarkerWithWaitList) { NAPI_ENV;
 	GET_WAIT_LIST(1);
 	cl_event event = nullptr;
 	cl_event* eventPtr = &event;
+	bool isEventHandle = IS_EVENT_HANDLE_FLAG(2);
 	
 	CHECK_ERR(clEnqueueMarkerWithWaitList(
 		clQueue,
@@ -976,6 +1243,7 @@ JS_METHOD(enqueueMarker) { NAPI_ENV;
 	
 	cl_event event = nullptr;
 	cl_event* eventPtr = &event;
+	bool isEventHandle = IS_EVENT_HANDLE_FLAG(1);
 	CHECK_ERR(clEnqueueMarkerWithWaitList(clQueue, 0, nullptr, eventPtr));
 	
 	RET_EVENT;
@@ -1042,5 +1310,133 @@ JS_METHOD(enqueueReleaseGLObjects) { NAPI_ENV;
 	RET_EVENT;
 }
 
+// SVM commands, the memory is referenced until they complete, as the SVM
+// ArrayBuffers are freed on GC
+
+JS_METHOD(enqueueSVMMap) { NAPI_ENV;
+	REQ_CL_ARG(0, queue, cl_command_queue);
+	SOFT_BOOL_ARG(1, blocking_map);
+	REQ_OFFS_ARG(2, map_flags);
+	REQ_OBJ_ARG(3, host);
+	REQ_SVM_API(api);
+	GET_HOST_PTR(host);
+	
+	GET_WAIT_LIST_AND_EVENT(4);
+	GET_TRANSFER_EVENT(blocking_map);
+	
+	CHECK_ERR(api->enqueueMap(
+		queue,
+		blocking_map,
+		map_flags,
+		ptr,
+		len,
+		(cl_uint) cl_events.size(),
+		cl_events.empty() ? nullptr : cl_events.data(),
+		transferEventPtr
+	));
+	KEEP_HOST_ALIVE(blocking_map, host);
+	
+	RET_EVENT;
+}
+
+
+JS_METHOD(enqueueSVMUnmap) { NAPI_ENV;
+	REQ_CL_ARG(0, queue, cl_command_queue);
+	REQ_OBJ_ARG(1, host);
+	REQ_SVM_API(api);
+	GET_HOST_PTR(host);
+	
+	GET_WAIT_LIST_AND_EVENT(2);
+	GET_TRANSFER_EVENT(false);
+	
+	CHECK_ERR(api->enqueueUnmap(
+		queue,
+		ptr,
+		(cl_uint) cl_events.size(),
+		cl_events.empty() ? nullptr : cl_events.data(),
+		transferEventPtr
+	));
+	KEEP_HOST_ALIVE(false, host);
+	
+	RET_EVENT;
+}
+
+
+JS_METHOD(enqueueSVMMemcpy) { NAPI_ENV;
+	REQ_CL_ARG(0, queue, cl_command_queue);
+	SOFT_BOOL_ARG(1, blocking_copy);
+	REQ_OBJ_ARG(2, dst);
+	REQ_OBJ_ARG(3, src);
+	REQ_OFFS_ARG(4, size);
+	REQ_SVM_API(api);
+	
+	GET_HOST_PTR_AS(dst, dstPtr, dstLen);
+	GET_HOST_PTR_AS(src, srcPtr, srcLen);
+	if (size > dstLen || size > srcLen) {
+		THROW_ERR(CL_INVALID_VALUE);
+	}
+	
+	GET_WAIT_LIST_AND_EVENT(5);
+	GET_TRANSFER_EVENT(blocking_copy);
+	
+	CHECK_ERR(api->enqueueMemcpy(
+		queue,
+		blocking_copy,
+		dstPtr,
+		srcPtr,
+		size,
+		(cl_uint) cl_events.size(),
+		cl_events.empty() ? nullptr : cl_events.data(),
+		transferEventPtr
+	));
+	
+	Napi::Array hosts = Napi::Array::New(env, 2);
+	hosts.Set(0u, dst);
+	hosts.Set(1u, src);
+	KEEP_HOST_ALIVE(blocking_copy, hosts);
+	
+	RET_EVENT;
+}
+
+
+JS_METHOD(enqueueSVMMemFill) { NAPI_ENV;
+	REQ_CL_ARG(0, queue, cl_command_queue);
+	REQ_OBJ_ARG(1, host);
+	REQ_SVM_API(api);
+	GET_HOST_PTR(host);
+	
+	void *pattern = nullptr;
+	size_t patternLen = 0;
+	if (info[2].IsNumber()) {
+		WEAK_UINT32_ARG(2, scalar_pattern);
+		pattern = &scalar_pattern;
+		patternLen = sizeof(scalar_pattern);
+	} else {
+		REQ_OBJ_ARG(2, buffer);
+		getPtrAndLen(buffer, &pattern, &patternLen);
+	}
+	
+	if (!pattern || !patternLen) {
+		JS_THROW("Could not read buffer data.");
+		RET_UNDEFINED;
+	}
+	
+	GET_WAIT_LIST_AND_EVENT(3);
+	GET_TRANSFER_EVENT(false);
+	
+	CHECK_ERR(api->enqueueMemFill(
+		queue,
+		ptr,
+		pattern,
+		patternLen,
+		len - len % patternLen,
+		(cl_uint) cl_events.size(),
+		cl_events.empty() ? nullptr : cl_events.data(),
+		transferEventPtr
+	));
+	KEEP_HOST_ALIVE(false, host);
+	
+	RET_EVENT;
+}
 
 } // namespace opencl
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <mutex>
+
+#include "wrapper.hpp"
+
+
+namespace opencl {
+
+// The smallest staging buffer, the larger ones are powers of 2
+#define STAGING_MIN_SIZE 4096
+
+// A CL_MEM_ALLOC_HOST_PTR buffer, mapped once for its whole life. Drivers back
+// such buffers with pinned memory, so transfers from/to it use the DMA path
+struct StagingSlot {
+	cl_context context;
+	cl_command_queue queue;
+	cl_mem mem;
+	void *ptr;
+	size_t capacity;
+	bool isUsed;
+	// The latest acquisition, so a stale finalizer can't free a newer lease
+	uint64_t lease;
+};
+
+// The finalizer hint of a staging ArrayBuffer
+struct StagingLease {
+	void *ptr;
+	uint64_t lease;
+};
+
+std::mutex stagingMutex;
+std::vector<StagingSlot> stagingSlots;
+uint64_t stagingLeaseCount = 0;
+
+
+// Gives the slot back, unless it was leased again since
+void returnStagingSlot(StagingLease *lease) {
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex);
+		for (StagingSlot &slot : stagingSlots) {
+			if (slot.ptr == lease->ptr && slot.lease == lease->lease) {
+				slot.isUsed = false;
+				break;
+			}
+		}
+	}
+	delete lease;
+}
+
+
+// A staging ArrayBuffer that was dropped without `releaseStagingBuffer()`
+// gives its slot back. A released (and maybe reused) slot is left as is
+void stagingFinalized(Napi::Env, void*, StagingLease *hint) {
+	returnStagingSlot(hint);
+}
+
+
+// Runs on a driver thread, when the transfers of a released slot are done
+void CL_CALLBACK stagingTransfersDone(cl_event, cl_int, void *ptr) {
+	returnStagingSlot(reinterpret_cast<StagingLease*>(ptr));
+}
+
+
+// The slot goes back to the pool once `events` complete. If that can't be
+// tracked, they are waited for right away
+void returnStagingSlotAfter(
+	cl_command_queue queue, const std::vector<cl_event> &events, StagingLease *lease
+) {
+	cl_event marker = nullptr;
+	cl_int err = clEnqueueMarkerWithWaitList(
+		queue, static_cast<cl_uint>(events.size()), events.data(), &marker
+	);
+	if (err == CL_SUCCESS) {
+		err = clSetEventCallback(marker, CL_COMPLETE, stagingTransfersDone, lease);
+		if (err == CL_SUCCESS) {
+			clFlush(queue);
+			clReleaseEvent(marker);
+			return;
+		}
+		clWaitForEvents(1, &marker);
+		clReleaseEvent(marker);
+	} else {
+		clWaitForEvents(static_cast<cl_uint>(events.size()), events.data());
+	}
+	returnStagingSlot(lease);
+}
+
+
+// Call with `stagingMutex` locked
+Napi::ArrayBuffer leaseStagingSlot(Napi::Env env, StagingSlot &slot, size_t size) {
+	slot.isUsed = true;
+	slot.lease = ++stagingLeaseCount;
+	return Napi::ArrayBuffer::New(
+		env, slot.ptr, size, stagingFinalized, new StagingLease { slot.ptr, slot.lease }
+	);
+}
+
+
+size_t getStagingCapacity(size_t size) {
+	size_t capacity = STAGING_MIN_SIZE;
+	while (capacity < size) {
+		capacity <<= 1;
+	}
+	return capacity;
+}
+
+
+JS_METHOD(acquireStagingBuffer) { NAPI_ENV;
+	REQ_CL_ARG(0, queue, cl_command_queue);
+	REQ_OFFS_ARG(1, size);
+	
+	if (!size) {
+		THROW_ERR(CL_INVALID_BUFFER_SIZE);
+	}
+	
+	cl_context context = nullptr;
+	CHECK_ERR(clGetCommandQueueInfo(
+		queue, CL_QUEUE_CONTEXT, sizeof(cl_context), &context, nullptr
+	));
+	
+	size_t capacity = getStagingCapacity(size);
+	
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex);
+		for (StagingSlot &slot : stagingSlots) {
+			if (!slot.isUsed && slot.context == context && slot.capacity == capacity) {
+				RET_VALUE(leaseStagingSlot(env, slot, size));
+			}
+		}
+	}
+	
+	cl_int err = CL_SUCCESS;
+	cl_mem mem = clCreateBuffer(
+		context, CL_MEM_READ_WRITE | CL_MEM_ALLOC_HOST_PTR, capacity, nullptr, &err
+	);
+	CHECK_ERR(err);
+	
+	void *ptr = clEnqueueMapBuffer(
+		queue, mem, CL_TRUE, CL_MAP_READ | CL_MAP_WRITE, 0, capacity,
+		0, nullptr, nullptr, &err
+	);
+	if (err != CL_SUCCESS) {
+		clReleaseMemObject(mem);
+		THROW_ERR(err);
+	}
+	
+	// The queue is needed to unmap the buffer on trim
+	clRetainCommandQueue(queue);
+	
+	std::lock_guard<std::mutex> lock(stagingMutex);
+	stagingSlots.push_back({ context, queue, mem, ptr, capacity, false, 0 });
+	RET_VALUE(leaseStagingSlot(env, stagingSlots.back(), size));
+}
+
+
+// The optional wait list holds the pending transfers of the buffer, the slot
+// is only reused after they complete. Detaching alone doesn't stop a transfer
+JS_METHOD(releaseStagingBuffer) { NAPI_ENV;
+	REQ_OBJ_ARG(0, host);
+	GET_WAIT_LIST(1);
+	
+	if (!host.IsArrayBuffer()) {
+		JS_THROW("Argument 0 must be a staging ArrayBuffer.");
+		RET_UNDEFINED;
+	}
+	Napi::ArrayBuffer arrayBuffer = host.As<Napi::ArrayBuffer>();
+	void *ptr = arrayBuffer.Data();
+	
+	bool isFound = false;
+	cl_command_queue queue = nullptr;
+	StagingLease *pending = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex);
+		for (StagingSlot &slot : stagingSlots) {
+			if (slot.isUsed && slot.ptr == ptr) {
+				isFound = true;
+				// The finalizer of the detached ArrayBuffer must not return it early
+				slot.lease = ++stagingLeaseCount;
+				if (cl_events.empty()) {
+					slot.isUsed = false;
+				} else {
+					queue = slot.queue;
+					pending = new StagingLease { slot.ptr, slot.lease };
+				}
+				break;
+			}
+		}
+	}
+	
+	if (!isFound) {
+		JS_THROW("Argument 0 must be a staging ArrayBuffer.");
+		RET_UNDEFINED;
+	}
+	
+	// Any views of the released memory become empty
+	arrayBuffer.Detach();
+	
+	if (pending) {
+		returnStagingSlotAfter(queue, cl_events, pending);
+	}
+	
+	RET_UNDEFINED;
+}
+
+
+JS_METHOD(trimStagingBuffers) { NAPI_ENV;
+	std::vector<StagingSlot> unused;
+	{
+		std::lock_guard<std::mutex> lock(stagingMutex);
+		auto firstUnused = std::stable_partition(
+			stagingSlots.begin(), stagingSlots.end(),
+			[](const StagingSlot &slot) { return slot.isUsed; }
+		);
+		unused.assign(firstUnused, stagingSlots.end());
+		stagingSlots.erase(firstUnused, stagingSlots.end());
+	}
+	
+	size_t freed = 0;
+	for (StagingSlot &slot : unused) {
+		clEnqueueUnmapMemObject(slot.queue, slot.mem, slot.ptr, 0, nullptr, nullptr);
+		clReleaseMemObject(slot.mem);
+		clReleaseCommandQueue(slot.queue);
+		freed += slot.capacity;
+	}
+	
+	RET_NUM(freed);
+}
+
+} // namespace opencl
@@ -0,0 +1,191 @@
+#include <mutex>
+#include <unordered_map>
+
+#include "svm.hpp"
+
+
+namespace opencl {
+
+const SvmApi *getSvmApi() {
+	static SvmApi api;
+	static bool isLoaded = [] {
+		api.alloc = reinterpret_cast<decltype(api.alloc)>(getClFunction("clSVMAlloc"));
+		api.free = reinterpret_cast<decltype(api.free)>(getClFunction("clSVMFree"));
+		api.setKernelArgPointer = reinterpret_cast<decltype(api.setKernelArgPointer)>(
+			getClFunction("clSetKernelArgSVMPointer")
+		);
+		api.setKernelExecInfo = reinterpret_cast<decltype(api.setKernelExecInfo)>(
+			getClFunction("clSetKernelExecInfo")
+		);
+		api.enqueueMap = reinterpret_cast<decltype(api.enqueueMap)>(
+			getClFunction("clEnqueueSVMMap")
+		);
+		api.enqueueUnmap = reinterpret_cast<decltype(api.enqueueUnmap)>(
+			getClFunction("clEnqueueSVMUnmap")
+		);
+		api.enqueueMemcpy = reinterpret_cast<decltype(api.enqueueMemcpy)>(
+			getClFunction("clEnqueueSVMMemcpy")
+		);
+		api.enqueueMemFill = reinterpret_cast<decltype(api.enqueueMemFill)>(
+			getClFunction("clEnqueueSVMMemFill")
+		);
+		return api.alloc && api.free && api.setKernelArgPointer &&
+			api.setKernelExecInfo && api.enqueueMap && api.enqueueUnmap &&
+			api.enqueueMemcpy && api.enqueueMemFill;
+	}();
+	return isLoaded ? &api : nullptr;
+}
+
+
+// The live SVM allocations, by pointer. An allocation is freed either by
+// `svmFree()` or by the finalizer of its ArrayBuffer, whichever comes first
+std::mutex svmMutex;
+std::unordered_map<void*, cl_context> svmAllocations;
+
+
+static bool takeSvmAllocation(void *ptr, cl_context *context) {
+	std::lock_guard<std::mutex> lock(svmMutex);
+	auto it = svmAllocations.find(ptr);
+	if (it == svmAllocations.end()) {
+		return false;
+	}
+	*context = it->second;
+	svmAllocations.erase(it);
+	return true;
+}
+
+
+static void freeSvmAllocation(void *ptr, cl_context context) {
+	getSvmApi()->free(context, ptr);
+	clReleaseContext(context);
+	Wrapper::countSvm(-1);
+}
+
+
+static void svmFinalized(Napi::Env, void *ptr) {
+	cl_context context = nullptr;
+	if (takeSvmAllocation(ptr, &context)) {
+		freeSvmAllocation(ptr, context);
+	}
+}
+
+
+JS_METHOD(svmAlloc) { NAPI_ENV;
+	REQ_CL_ARG(0, context, cl_context);
+	REQ_OFFS_ARG(1, flags);
+	REQ_OFFS_ARG(2, size);
+	USE_UINT32_ARG(3, alignment, 0);
+	REQ_SVM_API(api);
+	
+	if (!flags) {
+		flags = CL_MEM_READ_WRITE;
+	}
+	if (!size) {
+		THROW_ERR(CL_INVALID_BUFFER_SIZE);
+	}
+	
+	void *ptr = api->alloc(context, flags, size, alignment);
+	if (!ptr) {
+		THROW_ERR(CL_MEM_OBJECT_ALLOCATION_FAILURE);
+	}
+	
+	clRetainContext(context);
+	{
+		std::lock_guard<std::mutex> lock(svmMutex);
+		svmAllocations[ptr] = context;
+	}
+	Wrapper::countSvm(1);
+	
+	RET_VALUE(Napi::ArrayBuffer::New(env, ptr, size, svmFinalized));
+}
+
+
+JS_METHOD(svmFree) { NAPI_ENV;
+	REQ_OBJ_ARG(0, host);
+	REQ_SVM_API(api);
+	
+	if (!host.IsArrayBuffer()) {
+		JS_THROW("Argument 0 must be an SVM ArrayBuffer.");
+		RET_UNDEFINED;
+	}
+	Napi::ArrayBuffer arrayBuffer = host.As<Napi::ArrayBuffer>();
+	void *ptr = arrayBuffer.Data();
+	
+	cl_context context = nullptr;
+	if (!takeSvmAllocation(ptr, &context)) {
+		JS_THROW("Argument 0 must be an SVM ArrayBuffer.");
+		RET_UNDEFINED;
+	}
+	
+	// Any views of the freed memory become empty
+	arrayBuffer.Detach();
+	freeSvmAllocation(ptr, context);
+	
+	RET_UNDEFINED;
+}
+
+
+// The kernel Wrapper keeps the SVM memory it uses, until it is replaced
+JS_METHOD(setKernelArgSVMPointer) { NAPI_ENV;
+	REQ_CL_ARG(0, kernel, cl_kernel);
+	REQ_UINT32_ARG(1, arg_idx);
+	REQ_OBJ_ARG(2, host);
+	REQ_SVM_API(api);
+	
+	// A view may point inside of an allocation
+	void *ptr = nullptr;
+	getPtrAndLen(host, &ptr, nullptr);
+	if (!ptr) {
+		JS_THROW("Could not read buffer data.");
+		RET_UNDEFINED;
+	}
+	
+	CHECK_ERR(api->setKernelArgPointer(kernel, arg_idx, ptr));
+	_wrap_kernel->keepSvm(env, JS_NUM(arg_idx), host);
+	RET_UNDEFINED;
+}
+
+
+// The value is an Array of SVM views for CL_KERNEL_EXEC_INFO_SVM_PTRS,
+// and a Boolean for CL_KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM
+JS_METHOD(setKernelExecInfo) { NAPI_ENV;
+	REQ_CL_ARG(0, kernel, cl_kernel);
+	REQ_UINT32_ARG(1, param_name);
+	REQ_SVM_API(api);
+	
+	if (param_name == CL_KERNEL_EXEC_INFO_SVM_PTRS) {
+		REQ_ARRAY_ARG(2, hosts);
+		std::vector<void*> ptrs;
+		// A copy, so that later changes of `hosts` don't drop the references
+		Napi::Array kept = Napi::Array::New(env, hosts.Length());
+		for (uint32_t i = 0; i < hosts.Length(); i++) {
+			Napi::Value item = hosts.Get(i);
+			void *ptr = nullptr;
+			if (item.IsObject()) {
+				getPtrAndLen(item.As<Napi::Object>(), &ptr, nullptr);
+			}
+			if (!ptr) {
+				Wrapper::throwArrayEx(env, i, "is not an SVM ArrayBuffer or view.");
+				RET_UNDEFINED;
+			}
+			ptrs.push_back(ptr);
+			kept.Set(i, item);
+		}
+		CHECK_ERR(api->setKernelExecInfo(
+			kernel, param_name, ptrs.size() * sizeof(void*), ptrs.data()
+		));
+		_wrap_kernel->keepSvm(env, JS_STR("execInfo"), kept);
+		RET_UNDEFINED;
+	}
+	
+	if (param_name == CL_KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM) {
+		REQ_BOOL_ARG(2, isEnabled);
+		cl_bool value = isEnabled ? CL_TRUE : CL_FALSE;
+		CHECK_ERR(api->setKernelExecInfo(kernel, param_name, sizeof(cl_bool), &value));
+		RET_UNDEFINED;
+	}
+	
+	THROW_ERR(CL_INVALID_VALUE);
+}
+
+} // namespace opencl
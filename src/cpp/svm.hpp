@@ -0,0 +1,57 @@
+#pragma once
+
+#include "wrapper.hpp"
+
+
+// OpenCL 2.0 definitions, the headers only expose CL_TARGET_OPENCL_VERSION
+#ifndef CL_VERSION_2_0
+	typedef cl_bitfield cl_svm_mem_flags;
+	typedef cl_uint cl_kernel_exec_info;
+	
+	#define CL_DEVICE_SVM_CAPABILITIES 0x1053
+	#define CL_DEVICE_SVM_COARSE_GRAIN_BUFFER (1 << 0)
+	#define CL_DEVICE_SVM_FINE_GRAIN_BUFFER (1 << 1)
+	#define CL_DEVICE_SVM_FINE_GRAIN_SYSTEM (1 << 2)
+	#define CL_DEVICE_SVM_ATOMICS (1 << 3)
+	#define CL_MEM_SVM_FINE_GRAIN_BUFFER (1 << 10)
+	#define CL_MEM_SVM_ATOMICS (1 << 11)
+	#define CL_KERNEL_EXEC_INFO_SVM_PTRS 0x11B6
+	#define CL_KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM 0x11B7
+#endif
+
+
+namespace opencl {
+
+// The SVM entry points of the loaded OpenCL library, if it has any
+struct SvmApi {
+	void* (CL_API_CALL *alloc)(cl_context, cl_svm_mem_flags, size_t, cl_uint);
+	void (CL_API_CALL *free)(cl_context, void*);
+	cl_int (CL_API_CALL *setKernelArgPointer)(cl_kernel, cl_uint, const void*);
+	cl_int (CL_API_CALL *setKernelExecInfo)(cl_kernel, cl_kernel_exec_info, size_t, const void*);
+	cl_int (CL_API_CALL *enqueueMap)(
+		cl_command_queue, cl_bool, cl_map_flags, void*, size_t,
+		cl_uint, const cl_event*, cl_event*
+	);
+	cl_int (CL_API_CALL *enqueueUnmap)(
+		cl_command_queue, void*, cl_uint, const cl_event*, cl_event*
+	);
+	cl_int (CL_API_CALL *enqueueMemcpy)(
+		cl_command_queue, cl_bool, void*, const void*, size_t,
+		cl_uint, const cl_event*, cl_event*
+	);
+	cl_int (CL_API_CALL *enqueueMemFill)(
+		cl_command_queue, void*, const void*, size_t, size_t,
+		cl_uint, const cl_event*, cl_event*
+	);
+};
+
+// Returns `nullptr` if the library predates OpenCL 2.0
+const SvmApi *getSvmApi();
+
+#define REQ_SVM_API(VAR)                                                      \
+	const SvmApi *VAR = getSvmApi();                                          \
+	if (!VAR) {                                                               \
+		THROW_ERR(CL_INVALID_OPERATION);                                      \
+	}
+
+} // namespace opencl
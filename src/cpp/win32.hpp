@@ -0,0 +1,15 @@
+#pragma once
+
+// The windows.h prelude, common.gypi may already define some of these
+#ifdef _WIN32
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#ifndef NOGDI
+		#define NOGDI
+	#endif
+	#include <windows.h>
+#endif
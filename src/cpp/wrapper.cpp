@@ -1,3 +1,10 @@
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
 #include "wrapper.hpp"
 
 
@@ -53,8 +60,145 @@ TypeInfo typeInfo[] = {
 		reinterpret_cast<cl_func>(clReleaseEvent),
 		reinterpret_cast<cl_func>(clRetainEvent)
 	},
+	// Not wrapped, only counted, see `svmAlloc`
+	{ "svm_pointer", noop, noop },
 };
 
+#define TYPE_COUNT (sizeof(typeInfo) / sizeof(typeInfo[0]))
+#define SVM_TYPE_IDX (TYPE_COUNT - 1)
+
+// Auto-released Wrappers that still hold references, per type
+std::atomic<int32_t> liveCounts[TYPE_COUNT];
+
+std::atomic<bool> isAutoReleaseEnabled(false);
+
+
+// Live CL objects by handle, with the references taken through the Wrappers.
+// Opt-in, as every create and release goes through the map. See `setObjectTracking`
+class ObjectRegistry {
+public:
+	struct Entry {
+		uint8_t typeIdx;
+		int32_t refs;
+		uint64_t serial;
+		size_t bytes;
+		std::chrono::steady_clock::time_point createdAt;
+		std::string site;
+	};
+	
+	std::atomic<bool> isEnabled = false;
+	std::atomic<bool> isCapturingStacks = false;
+	
+	void add(void *handle, uint8_t typeIdx, const std::string &site) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _entries.find(handle);
+		if (it != _entries.end()) {
+			it->second.refs++;
+			return;
+		}
+		
+		Entry entry = { typeIdx, 1, ++_serial, 0, std::chrono::steady_clock::now(), site };
+		if (strcmp(typeInfo[typeIdx].typeName, "cl_mem") == 0) {
+			clGetMemObjectInfo(
+				reinterpret_cast<cl_mem>(handle), CL_MEM_SIZE, sizeof(size_t), &entry.bytes, nullptr
+			);
+		}
+		_entries.emplace(handle, std::move(entry));
+	}
+	
+	// Untracked handles (e.g. created before tracking was on) are ignored
+	void remove(void *handle, int32_t refs) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _entries.find(handle);
+		if (it == _entries.end()) {
+			return;
+		}
+		it->second.refs -= refs;
+		if (it->second.refs <= 0) {
+			_entries.erase(it);
+		}
+	}
+	
+	void clear() {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_entries.clear();
+	}
+	
+	Napi::Object getStats(Napi::Env env) {
+		uint32_t counts[TYPE_COUNT] = {};
+		double bytes[TYPE_COUNT] = {};
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (const auto &it : _entries) {
+				counts[it.second.typeIdx]++;
+				bytes[it.second.typeIdx] += static_cast<double>(it.second.bytes);
+			}
+		}
+		
+		Napi::Object result = Napi::Object::New(env);
+		for (size_t i = 0; i < TYPE_COUNT; i++) {
+			if (typeInfo[i].release == noop) {
+				continue;
+			}
+			Napi::Object stats = Napi::Object::New(env);
+			stats.Set("count", JS_NUM(counts[i]));
+			stats.Set("bytes", JS_NUM(bytes[i]));
+			result.Set(typeInfo[i].typeName, stats);
+		}
+		return result;
+	}
+	
+	// The oldest live objects first
+	Napi::Array getOldest(Napi::Env env, size_t limit) {
+		std::vector<std::pair<void*, Entry>> oldest;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			oldest.assign(_entries.begin(), _entries.end());
+		}
+		size_t count = std::min(limit, oldest.size());
+		std::partial_sort(
+			oldest.begin(), oldest.begin() + count, oldest.end(),
+			[](const auto &a, const auto &b) { return a.second.serial < b.second.serial; }
+		);
+		
+		auto now = std::chrono::steady_clock::now();
+		Napi::Array result = Napi::Array::New(env, count);
+		for (size_t i = 0; i < count; i++) {
+			const Entry &entry = oldest[i].second;
+			double ageMs = std::chrono::duration<double, std::milli>(now - entry.createdAt).count();
+			
+			Napi::Object item = Napi::Object::New(env);
+			item.Set("type", typeInfo[entry.typeIdx].typeName);
+			item.Set("handle", JS_NUM(static_cast<double>(reinterpret_cast<uintptr_t>(oldest[i].first))));
+			item.Set("serial", JS_NUM(static_cast<double>(entry.serial)));
+			item.Set("refs", JS_NUM(entry.refs));
+			item.Set("bytes", JS_NUM(static_cast<double>(entry.bytes)));
+			item.Set("ageMs", JS_NUM(ageMs));
+			item.Set("site", entry.site.empty() ? JS_NULL : JS_STR(entry.site));
+			result.Set(i, item);
+		}
+		return result;
+	}
+	
+	// JS stack of the current native call, without the "Error" header line
+	static std::string getSite(Napi::Env env) {
+		Napi::Value stack = Napi::Error::New(env, "").Value().Get("stack");
+		if (!stack.IsString()) {
+			return "";
+		}
+		std::string site = stack.ToString().Utf8Value();
+		size_t lineEnd = site.find('\n');
+		return lineEnd == std::string::npos ? "" : site.substr(lineEnd + 1);
+	}
+	
+private:
+	std::mutex _mutex;
+	std::unordered_map<void*, Entry> _entries;
+	uint64_t _serial = 0;
+};
+
+ObjectRegistry registry;
+
 
 IMPLEMENT_ES5_CLASS(Wrapper);
 
@@ -63,6 +207,7 @@ void Wrapper::init(Napi::Env env, Napi::Object exports) {
 	Napi::Function ctor = wrap(env);
 	JS_ASSIGN_METHOD(toString);
 	JS_ASSIGN_METHOD(valueOf);
+	JS_ASSIGN_METHOD(dispose);
 	JS_ASSIGN_GETTER(_);
 	exports.Set("Wrapper", ctor);
 }
@@ -100,9 +245,13 @@ Napi::Object Wrapper::from(Napi::Env env, cl_event raw) {
 Wrapper::Wrapper(const Napi::CallbackInfo& info) { NAPI_ENV;
 	super(info);
 	
-	if (!info[0].IsExternal() || !info[1].IsNumber()) {
+	_refs = 0;
+	_isAutoRelease = false;
+	
+	int32_t infoIdx = info[1].IsNumber() ? info[1].ToNumber().Int32Value() : 0;
+	if (!info[0].IsExternal() || infoIdx <= 0 || infoIdx >= static_cast<int32_t>(SVM_TYPE_IDX)) {
 		_data = nullptr;
-		_released = 0;
+		_typeIdx = 0;
 		_acquire = typeInfo[0].acquire;
 		_release = typeInfo[0].release;
 		_typeName = typeInfo[0].typeName;
@@ -111,16 +260,76 @@ Wrapper::Wrapper(const Napi::CallbackInfo& info) { NAPI_ENV;
 	}
 	
 	Napi::External<void> extParam = info[0].As< Napi::External<void> >();
-	int32_t infoIdx = info[1].ToNumber().Int32Value();
 	
 	_data = extParam.Data();
+	_typeIdx = static_cast<uint8_t>(infoIdx);
 	_acquire = typeInfo[infoIdx].acquire;
 	_release = typeInfo[infoIdx].release;
 	_typeName = typeInfo[infoIdx].typeName;
+	
+	// The new Wrapper takes over the reference returned by the CL call
+	if (_release != noop) {
+		_isAutoRelease = isAutoReleaseEnabled;
+		_setRefs(1);
+		if (registry.isEnabled) {
+			registry.add(
+				_data, _typeIdx, registry.isCapturingStacks ? ObjectRegistry::getSite(env) : ""
+			);
+		}
+	}
 }
 
 
 Wrapper::~Wrapper() {
+	if (_isAutoRelease) {
+		_releaseHeld();
+	}
+}
+
+
+void Wrapper::_releaseHeld() {
+	if (_refs) {
+		registry.remove(_data, _refs);
+	}
+	while (_refs) {
+		_release(_data);
+		_setRefs(_refs - 1);
+	}
+}
+
+
+void Wrapper::_disown() {
+	if (_refs) {
+		registry.remove(_data, _refs);
+	}
+	_setRefs(0);
+}
+
+
+void Wrapper::_setRefs(uint32_t refs) {
+	if (_isAutoRelease && !_refs != !refs) {
+		liveCounts[_typeIdx] += refs ? 1 : -1;
+	}
+	_refs = refs;
+}
+
+
+void Wrapper::setAutoRelease(bool isEnabled) {
+	isAutoReleaseEnabled = isEnabled;
+}
+
+
+void Wrapper::countSvm(int32_t delta) {
+	liveCounts[SVM_TYPE_IDX] += delta;
+}
+
+
+void Wrapper::getLiveCounts(Napi::Object out) {
+	for (size_t i = 0; i < TYPE_COUNT; i++) {
+		if (typeInfo[i].release != noop || i == SVM_TYPE_IDX) {
+			out.Set(typeInfo[i].typeName, static_cast<double>(liveCounts[i]));
+		}
+	}
 }
 
 
@@ -134,6 +343,20 @@ JS_IMPLEMENT_METHOD(Wrapper, valueOf) { NAPI_ENV;
 	RET_X64(reinterpret_cast<uint64_t>(_data));
 }
 
+// Releases the references held by this Wrapper, it can't be used afterwards
+JS_IMPLEMENT_METHOD(Wrapper, dispose) { NAPI_ENV;
+	if (_refs) {
+		registry.remove(_data, _refs);
+	}
+	while (_refs) {
+		cl_int err = _release(_data);
+		_setRefs(_refs - 1);
+		CHECK_ERR(err);
+	}
+	_data = nullptr;
+	RET_UNDEFINED;
+}
+
 JS_IMPLEMENT_GETTER(Wrapper, _) { NAPI_ENV;
 	RET_X64(reinterpret_cast<uint64_t>(_data));
 }
@@ -145,13 +368,118 @@ void Wrapper::throwArrayEx(Napi::Env env, int i, const char* msg) {
 }
 
 
+void Wrapper::copyKernelArgs(Napi::Env env, const Wrapper *source) {
+	_kernelArgs = source->_kernelArgs;
+	Napi::Value refs = source->copySvmRefs(env);
+	if (refs.IsObject()) {
+		_svmRefs.Reset(refs.As<Napi::Object>(), 1);
+	}
+}
+
+
+Napi::Value Wrapper::copySvmRefs(Napi::Env env) const {
+	if (_svmRefs.IsEmpty()) {
+		return env.Undefined();
+	}
+	
+	Napi::Object refs = _svmRefs.Value();
+	Napi::Object copy = Napi::Object::New(env);
+	Napi::Array keys = refs.GetPropertyNames();
+	for (uint32_t i = 0; i < keys.Length(); i++) {
+		Napi::Value key = keys.Get(i);
+		copy.Set(key, refs.Get(key));
+	}
+	return copy;
+}
+
+
+void Wrapper::keepSvm(Napi::Env env, Napi::Value key, Napi::Value host) {
+	if (_svmRefs.IsEmpty()) {
+		_svmRefs.Reset(Napi::Object::New(env), 1);
+	}
+	_svmRefs.Value().Set(key, host);
+}
+
+
 cl_int Wrapper::acquire() {
-	return _acquire(_data);
+	cl_int err = _acquire(_data);
+	if (err == CL_SUCCESS && _release != noop) {
+		_setRefs(_refs + 1);
+		if (registry.isEnabled) {
+			registry.add(_data, _typeIdx, "");
+		}
+	}
+	return err;
 }
 
 
 cl_int Wrapper::release() {
-	return _release(_data);
+	// An auto-released Wrapper never releases more than it holds
+	if (_isAutoRelease && !_refs) {
+		_data = nullptr;
+	}
+	
+	cl_int err = _release(_data);
+	if (err == CL_SUCCESS) {
+		registry.remove(_data, 1);
+		if (_refs) {
+			_setRefs(_refs - 1);
+		}
+	}
+	return err;
+}
+
+
+cl_int Wrapper::detach() {
+	if (!_refs) {
+		return _acquire(_isAutoRelease ? nullptr : _data);
+	}
+	
+	registry.remove(_data, 1);
+	_setRefs(_refs - 1);
+	if (_isAutoRelease && !_refs) {
+		_data = nullptr;
+	}
+	return CL_SUCCESS;
+}
+
+
+JS_METHOD(setAutoRelease) { NAPI_ENV;
+	REQ_BOOL_ARG(0, isEnabled);
+	Wrapper::setAutoRelease(isEnabled);
+	RET_UNDEFINED;
+}
+
+
+JS_METHOD(setObjectTracking) { NAPI_ENV;
+	REQ_BOOL_ARG(0, isEnabled);
+	SOFT_BOOL_ARG(1, isCapturingStacks);
+	
+	if (!isEnabled) {
+		registry.clear();
+	}
+	registry.isCapturingStacks = isCapturingStacks;
+	registry.isEnabled = isEnabled;
+	
+	RET_UNDEFINED;
+}
+
+
+JS_METHOD(getObjectStats) { NAPI_ENV;
+	RET_VALUE(registry.getStats(env));
+}
+
+
+JS_METHOD(getLiveObjects) { NAPI_ENV;
+	USE_UINT32_ARG(0, limit, 10);
+	RET_VALUE(registry.getOldest(env, limit));
+}
+
+
+JS_METHOD(getLiveObjectCounts) { NAPI_ENV;
+	Napi::Object result = Napi::Object::New(env);
+	Wrapper::getLiveCounts(result);
+	RET_VALUE(result);
 }
 
 } // namespace opencl
@@ -5,12 +5,27 @@
 #include <sstream>
 
 #include "common.hpp"
+#include "event-table.hpp"
 
 
 namespace opencl {
 
 typedef int (*cl_func)(void*);
 
+// The largest primitive kernel argument is double16
+#define KERNEL_ARG_SCRATCH_SIZE 128
+
+// Converts a JS value to a primitive kernel argument, writing it to `out`
+// (at least KERNEL_ARG_SCRATCH_SIZE bytes) and its byte length to `size`
+typedef cl_int (*ArgConverter)(Napi::Value val, void *out, size_t *size);
+
+// Resolved kernel argument signature, see setKernelArg
+struct KernelArg {
+	enum Kind : uint8_t { Unknown = 0, Local, Mem, Sampler, Primitive };
+	Kind kind;
+	ArgConverter converter;
+};
+
 
 class Wrapper {
 DECLARE_ES5_CLASS(Wrapper, Wrapper);
@@ -28,18 +43,62 @@ public:
 	static Napi::Object from(Napi::Env env, cl_command_queue raw);
 	static Napi::Object from(Napi::Env env, cl_event raw);
 	
+	// Wraps an object without taking over a reference (e.g. in callbacks).
+	// With auto-release on, the Wrapper retains a reference of its own
+	template <typename T>
+	static Napi::Object fromBorrowed(Napi::Env env, T raw) {
+		Napi::Object obj = from(env, raw);
+		Wrapper *wrapper = unwrap(obj);
+		if (!wrapper->_isAutoRelease || wrapper->_acquire(raw) != CL_SUCCESS) {
+			wrapper->_disown();
+		}
+		return obj;
+	}
+	
+	// Wrappers created while enabled release their references on GC
+	static void setAutoRelease(bool isEnabled);
+	static void getLiveCounts(Napi::Object out);
+	// SVM allocations are GC-owned ArrayBuffers, counted as "svm_pointer"
+	static void countSvm(int32_t delta);
+	
 	explicit Wrapper(const Napi::CallbackInfo& info);
 	~Wrapper();
 	
 	JS_DECLARE_METHOD(Wrapper, toString);
 	JS_DECLARE_METHOD(Wrapper, valueOf);
+	JS_DECLARE_METHOD(Wrapper, dispose);
 	JS_DECLARE_GETTER(Wrapper, _);
 	
 	cl_int acquire();
 	cl_int release();
+	// Hands one held reference over to the caller, like `release()` does,
+	// but without releasing it. A Wrapper that holds none retains one
+	cl_int detach();
 	
 	template <typename T> T as() { return reinterpret_cast<T>(_data); }
 	
+	// Kernel argument signatures, resolved on first use (cl_kernel only)
+	const KernelArg *findKernelArg(cl_uint idx) const {
+		if (idx >= _kernelArgs.size() || _kernelArgs[idx].kind == KernelArg::Unknown) {
+			return nullptr;
+		}
+		return &_kernelArgs[idx];
+	}
+	void cacheKernelArg(cl_uint idx, const KernelArg &arg) {
+		if (idx >= _kernelArgs.size()) {
+			_kernelArgs.resize(idx + 1, { KernelArg::Unknown, nullptr });
+		}
+		_kernelArgs[idx] = arg;
+	}
+	// A cloned kernel has the same signature and SVM args as its source
+	void copyKernelArgs(Napi::Env env, const Wrapper *source);
+	// Keeps the SVM memory set on a kernel from being freed on GC.
+	// `key` is the arg index, or "execInfo" for the SVM pointer list
+	void keepSvm(Napi::Env env, Napi::Value key, Napi::Value host);
+	// The SVM memory of the current args, `undefined` if none. A launch keeps
+	// this copy until it completes, as `clSVMFree()` doesn't wait for it
+	Napi::Value copySvmRefs(Napi::Env env) const;
+	
 	static void throwArrayEx(Napi::Env env, int i, const char* msg);
 	
 	// return 0 === success
@@ -61,20 +120,87 @@ public:
 		return 0;
 	}
 	
+	// Same as `fromJsArray`, but also accepts numeric event handles.
+	// The handles are only looked up here, and recorded in `consumed`
+	static int fromJsWaitList(
+		Napi::Array src, std::vector<cl_event> *out, ConsumedEvents *consumed
+	) {
+		for (size_t i = 0; i < src.Length(); i++) {
+			Napi::Value value = src.Get(i);
+			if (value.IsNumber()) {
+				double handle = value.As<Napi::Number>().DoubleValue();
+				cl_event event = EventTable::peek(handle);
+				if (!event) {
+					throwArrayEx(src.Env(), i, "is not a live event handle.");
+					return -1;
+				}
+				consumed->push(handle);
+				out->push_back(event);
+				continue;
+			}
+			if (!value.IsObject()) {
+				throwArrayEx(src.Env(), i, "is not an Object.");
+				return -1;
+			}
+			Wrapper *wrapper = Wrapper::unwrap(value.As<Napi::Object>());
+			if (!wrapper) {
+				throwArrayEx(src.Env(), i, "is not a CL Wrapper.");
+				return -1;
+			}
+			out->push_back(wrapper->as<cl_event>());
+		}
+		return 0;
+	}
+	
 private:
 	void *_data;
 	cl_func _acquire;
 	cl_func _release;
-	uint16_t _released;
 	const char *_typeName;
+	uint8_t _typeIdx;
+	bool _isAutoRelease;
+	// References that this Wrapper holds, released by `dispose()`
+	uint32_t _refs;
+	std::vector<KernelArg> _kernelArgs;
+	Napi::ObjectReference _svmRefs;
 	
+	void _setRefs(uint32_t refs);
+	void _releaseHeld();
+	void _disown();
 };
 
+// Sets kernel args from `values` by index, `types` is an optional Array of
+// type names. Returns `false` if a JS exception was thrown (see kernel.cpp)
+bool bindKernelArgs(
+	Napi::Env env, Wrapper *kernelWrapper, Napi::Array values, Napi::Value types
+);
+
+// Reads 1 to 3 work sizes from a Number or an Array. Returns the count,
+// or 0 if the value is malformed (see queue.cpp)
+cl_uint readWorkSizes(Napi::Value value, size_t *out);
+
+// Reads up to 3 components of an image origin/region, the rest stay as they
+// are (see queue.cpp)
+void readImageCoords(Napi::Array arr, size_t *coords);
+
+// Introspects (or takes from cache) the signature of a kernel argument
+cl_int resolveKernelArg(
+	Wrapper *kernelWrapper, cl_uint arg_idx, KernelArg *arg, std::string *type_name
+);
+
+// Converts a JS value into the clSetKernelArg payload (KERNEL_ARG_SCRATCH_SIZE
+// bytes at most). For local args only `size` is set. On a JS type mismatch,
+// `msg` is set to be prefixed with the argument position
+cl_int encodeKernelArg(
+	const KernelArg &arg, Napi::Value value, void *data, size_t *size, const char **msg
+);
+
 #define GET_WAIT_LIST(n)                                                      \
 	std::vector<cl_event> cl_events;                                          \
+	ConsumedEvents consumed_events(env);                                      \
 	if (!IS_ARG_EMPTY(n)) {                                                   \
 		REQ_ARRAY_ARG(n, js_events);                                          \
-		if (Wrapper::fromJsArray(js_events, &cl_events)) {                    \
+		if (Wrapper::fromJsWaitList(js_events, &cl_events, &consumed_events)) { \
 			RET_UNDEFINED;                                                    \
 		}                                                                     \
 	}
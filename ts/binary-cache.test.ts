@@ -0,0 +1,65 @@
+import fs from 'node:fs';
+import { strict as assert } from 'node:assert';
+import { describe, it, after } from 'node:test';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import * as cl from './index.ts';
+
+const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
+
+
+describe('BinaryCache', () => {
+	const { context, device } = cl.quickStart();
+	const dir = fs.mkdtempSync(join(tmpdir(), 'opencl-cache-'));
+	
+	after(() => {
+		fs.rmSync(dir, { recursive: true, force: true });
+	});
+	
+	describe('#createBinaryCache', () => {
+		it('builds from source once, then from the binary', () => {
+			const cache = cl.createBinaryCache({ dir });
+			cl.releaseProgram(cache.build(context, device, squareKern));
+			
+			const cacheNext = cl.createBinaryCache({ dir });
+			const program = cacheNext.build(context, device, squareKern);
+			const kernel = cl.createKernel(program, 'square');
+			cl.releaseKernel(kernel);
+			cl.releaseProgram(program);
+			
+			assert.deepStrictEqual(cache.getStats(), { hits: 0, misses: 1, writes: 1, rejects: 0 });
+			assert.deepStrictEqual(cacheNext.getStats(), { hits: 1, misses: 0, writes: 0, rejects: 0 });
+		});
+		
+		it('keeps the binaries of other drivers', () => {
+			const otherDir = join(dir, 'other-driver');
+			fs.mkdirSync(otherDir, { recursive: true });
+			fs.writeFileSync(join(otherDir, 'program.bin'), 'binary');
+			
+			const cache = cl.createBinaryCache({ dir });
+			cl.releaseProgram(cache.build(context, device, squareKern, '-DOTHER'));
+			assert.ok(fs.existsSync(join(otherDir, 'program.bin')));
+		});
+		
+		it('hits the cache for the same source and options', () => {
+			const cache = cl.createBinaryCache({ dir });
+			cl.releaseProgram(cache.build(context, device, squareKern, '-cl-fast-relaxed-math'));
+			cl.releaseProgram(cache.build(context, device, squareKern, '-cl-fast-relaxed-math'));
+			assert.strictEqual(cache.getStats().hits, 1);
+		});
+		
+		it('rebuilds from source if the binary is corrupt', () => {
+			const cache = cl.createBinaryCache({ dir });
+			cl.releaseProgram(cache.build(context, device, squareKern, '-DCORRUPT'));
+			
+			const files = fs.readdirSync(dir, { recursive: true, withFileTypes: true })
+				.filter((entry) => entry.name.endsWith('.bin'));
+			for (const file of files) {
+				fs.writeFileSync(join(file.parentPath, file.name), 'garbage');
+			}
+			
+			cl.releaseProgram(cache.build(context, device, squareKern, '-DCORRUPT'));
+			assert.strictEqual(cache.getStats().rejects, 1);
+		});
+	});
+});
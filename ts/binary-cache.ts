@@ -0,0 +1,212 @@
+import { createHash } from 'node:crypto';
+import {
+	existsSync, mkdirSync, readdirSync, readFileSync, renameSync, rmdirSync, rmSync, statSync, utimesSync,
+	writeFileSync,
+} from 'node:fs';
+import { join } from 'node:path';
+import { native } from './native.ts';
+import type { TClContext, TClDevice, TClProgram } from './native.ts';
+
+const {
+	createProgramWithSource,
+	createProgramWithBinary,
+	buildProgram,
+	releaseProgram,
+	getProgramInfo,
+	getDeviceInfo,
+	DEVICE_NAME,
+	DEVICE_VERSION,
+	DRIVER_VERSION,
+	PROGRAM_BINARIES,
+	PROGRAM_DEVICES,
+} = native;
+
+export type TBinaryCacheOptions = Readonly<{
+	/** The cache directory, created if missing. */
+	dir: string;
+	/** Total size of the cached binaries, 256 MiB by default. The oldest go first. */
+	maxBytes?: number;
+}>;
+
+export type TBinaryCacheStats = Readonly<{
+	hits: number;
+	misses: number;
+	writes: number;
+	/** Cached binaries that failed to load, and were rebuilt from source. */
+	rejects: number;
+}>;
+
+export type TBinaryCache = {
+	/** Build a program for `device`, from a cached binary if possible. */
+	build: (context: TClContext, device: TClDevice, source: string, options?: string) => TClProgram;
+	getStats: () => TBinaryCacheStats;
+	/** Delete all of the cached binaries. */
+	clear: () => void;
+};
+
+const BINARY_EXT = '.bin';
+
+const hash = (...parts: readonly string[]): string => {
+	const hasher = createHash('sha256');
+	for (const part of parts) {
+		hasher.update(part);
+		hasher.update('\0');
+	}
+	return hasher.digest('hex');
+};
+
+// Concurrent writers each use their own temp file, then the rename is atomic
+export const writeAtomic = (path: string, data: Uint8Array | string): void => {
+	const temp = `${path}.${process.pid}.${Math.random().toString(36).slice(2)}.tmp`;
+	try {
+		writeFileSync(temp, data);
+		renameSync(temp, path);
+	} catch (error) {
+		rmSync(temp, { force: true });
+		throw error;
+	}
+};
+
+/**
+ * Cache program binaries on disk, per device and driver version.
+ *
+ * Each device name, device version and driver version has its own directory,
+ * so different drivers share the cache without evicting each other. The binaries
+ * of the drivers that are gone age out, as the least recently used go first.
+ * A corrupt or rejected binary falls back to the source.
+ */
+export const createBinaryCache = (options: TBinaryCacheOptions): TBinaryCache => {
+	const { dir, maxBytes = 256 * 1024 * 1024 } = options;
+	
+	let hits = 0;
+	let misses = 0;
+	let writes = 0;
+	let rejects = 0;
+	
+	const checkedDirs = new Set<string>();
+	
+	const getDeviceDir = (device: TClDevice): string => {
+		const deviceDir = join(dir, hash(
+			String(getDeviceInfo(device, DEVICE_NAME)),
+			String(getDeviceInfo(device, DEVICE_VERSION)),
+			String(getDeviceInfo(device, DRIVER_VERSION)),
+		).slice(0, 16));
+		if (!checkedDirs.has(deviceDir)) {
+			mkdirSync(deviceDir, { recursive: true });
+			checkedDirs.add(deviceDir);
+		}
+		return deviceDir;
+	};
+	
+	// Removes the directories left empty, e.g. of an uninstalled driver
+	const removeEmptyDirs = (): void => {
+		for (const entry of readdirSync(dir, { withFileTypes: true })) {
+			const path = join(dir, entry.name);
+			if (entry.isDirectory() && !checkedDirs.has(path) && !readdirSync(path).length) {
+				rmdirSync(path);
+			}
+		}
+	};
+	
+	const prune = (): void => {
+		const files = readdirSync(dir, { recursive: true, withFileTypes: true })
+			.filter((entry) => entry.isFile() && entry.name.endsWith(BINARY_EXT))
+			.map((entry) => {
+				const path = join(entry.parentPath, entry.name);
+				const { size, mtimeMs } = statSync(path);
+				return { path, size, mtimeMs };
+			})
+			.toSorted((a, b) => a.mtimeMs - b.mtimeMs);
+		
+		let total = files.reduce((sum, file) => sum + file.size, 0);
+		for (const file of files) {
+			if (total <= maxBytes) {
+				break;
+			}
+			rmSync(file.path, { force: true });
+			total -= file.size;
+		}
+		removeEmptyDirs();
+	};
+	
+	const loadBinary = (
+		context: TClContext, device: TClDevice, path: string, buildOptions: string,
+	): TClProgram | null => {
+		let binary: Buffer;
+		try {
+			binary = readFileSync(path);
+		} catch {
+			return null;
+		}
+		
+		let program: TClProgram | null = null;
+		try {
+			program = createProgramWithBinary(context, [device], [binary]);
+			buildProgram(program, [device], buildOptions);
+		} catch {
+			if (program) {
+				releaseProgram(program);
+			}
+			rmSync(path, { force: true });
+			rejects++;
+			return null;
+		}
+		
+		// Keeps the recently used binaries from being pruned
+		const now = new Date();
+		utimesSync(path, now, now);
+		return program;
+	};
+	
+	const saveBinary = (program: TClProgram, device: TClDevice, path: string): void => {
+		const devices = getProgramInfo(program, PROGRAM_DEVICES) as TClDevice[];
+		const binaries = getProgramInfo(program, PROGRAM_BINARIES) as ArrayBuffer[];
+		const index = devices.findIndex((d) => d._ === device._);
+		const binary = binaries[index];
+		if (!binary?.byteLength) {
+			return;
+		}
+		
+		writeAtomic(path, new Uint8Array(binary));
+		writes++;
+		prune();
+	};
+	
+	return {
+		build: (context, device, source, buildOptions = ''): TClProgram => {
+			const deviceDir = getDeviceDir(device);
+			const path = join(deviceDir, `${hash(source, buildOptions)}${BINARY_EXT}`);
+			
+			const cached = existsSync(path) ? loadBinary(context, device, path, buildOptions) : null;
+			if (cached) {
+				hits++;
+				return cached;
+			}
+			
+			misses++;
+			const program = createProgramWithSource(context, source);
+			try {
+				buildProgram(program, [device], buildOptions);
+			} catch (error) {
+				releaseProgram(program);
+				throw error;
+			}
+			
+			// A read-only or full disk only costs the next startup a rebuild
+			try {
+				saveBinary(program, device, path);
+			} catch {
+				// Not cached
+			}
+			
+			return program;
+		},
+		
+		getStats: (): TBinaryCacheStats => ({ hits, misses, writes, rejects }),
+		
+		clear: (): void => {
+			rmSync(dir, { recursive: true, force: true });
+			checkedDirs.clear();
+		},
+	};
+};
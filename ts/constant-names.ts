@@ -99,6 +99,8 @@ export type TNumericConstantName =
 	| 'DEVICE_REFERENCE_COUNT'
 	| 'DEVICE_PREFERRED_INTEROP_USER_SYNC'
 	| 'DEVICE_PRINTF_BUFFER_SIZE'
+	| 'DEVICE_SVM_CAPABILITIES'
+	| 'DEVICE_IL_VERSION'
 	| 'FP_DENORM'
 	| 'FP_INF_NAN'
 	| 'FP_ROUND_TO_NEAREST'
@@ -114,6 +116,10 @@ export type TNumericConstantName =
 	| 'GLOBAL'
 	| 'EXEC_KERNEL'
 	| 'EXEC_NATIVE_KERNEL'
+	| 'DEVICE_SVM_COARSE_GRAIN_BUFFER'
+	| 'DEVICE_SVM_FINE_GRAIN_BUFFER'
+	| 'DEVICE_SVM_FINE_GRAIN_SYSTEM'
+	| 'DEVICE_SVM_ATOMICS'
 	| 'QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE'
 	| 'QUEUE_PROFILING_ENABLE'
 	| 'CONTEXT_REFERENCE_COUNT'
@@ -145,6 +151,8 @@ export type TNumericConstantName =
 	| 'MEM_HOST_WRITE_ONLY'
 	| 'MEM_HOST_READ_ONLY'
 	| 'MEM_HOST_NO_ACCESS'
+	| 'MEM_SVM_FINE_GRAIN_BUFFER'
+	| 'MEM_SVM_ATOMICS'
 	| 'MIGRATE_MEM_OBJECT_HOST'
 	| 'MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED'
 	| 'R'
@@ -228,6 +236,7 @@ export type TNumericConstantName =
 	| 'PROGRAM_BINARIES'
 	| 'PROGRAM_NUM_KERNELS'
 	| 'PROGRAM_KERNEL_NAMES'
+	| 'PROGRAM_IL'
 	| 'PROGRAM_BUILD_STATUS'
 	| 'PROGRAM_BUILD_OPTIONS'
 	| 'PROGRAM_BUILD_LOG'
@@ -246,6 +255,8 @@ export type TNumericConstantName =
 	| 'KERNEL_CONTEXT'
 	| 'KERNEL_PROGRAM'
 	| 'KERNEL_ATTRIBUTES'
+	| 'KERNEL_EXEC_INFO_SVM_PTRS'
+	| 'KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM'
 	| 'KERNEL_ARG_ADDRESS_QUALIFIER'
 	| 'KERNEL_ARG_ACCESS_QUALIFIER'
 	| 'KERNEL_ARG_TYPE_NAME'
@@ -6,7 +6,7 @@ import * as U from './utils.ts';
 
 
 describe('Event', () => {
-	const { context } = cl.quickStart();
+	const { context, device } = cl.quickStart();
 	
 	describe('#createUserEvent', () => {
 		it('creates a user Event', () => {
@@ -106,6 +106,96 @@ describe('Event', () => {
 		});
 	});
 	
+	describe('#waitForEventsAsync', () => {
+		it('resolves when all events complete', async () => {
+			const userEvent1 = cl.createUserEvent(context);
+			const userEvent2 = cl.createUserEvent(context);
+			const promise = cl.waitForEventsAsync([userEvent1, userEvent2]);
+			
+			cl.setUserEventStatus(userEvent1, cl.COMPLETE);
+			cl.setUserEventStatus(userEvent2, cl.COMPLETE);
+			
+			assert.strictEqual(await promise, undefined);
+			cl.releaseEvent(userEvent1);
+			cl.releaseEvent(userEvent2);
+		});
+		
+		it('rejects if an event is terminated', async () => {
+			const userEvent = cl.createUserEvent(context);
+			const promise = cl.waitForEventsAsync([userEvent]);
+			
+			cl.setUserEventStatus(userEvent, -14); // CL_EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST
+			
+			await assert.rejects(promise, cl.EXEC_STATUS_ERROR_FOR_EVENTS_IN_WAIT_LIST);
+			cl.releaseEvent(userEvent);
+		});
+		
+		it('throws for an empty list', () => {
+			assert.throws(
+				() => cl.waitForEventsAsync([]),
+				cl.INVALID_VALUE,
+			);
+		});
+	});
+	
+	describe('Event handles', () => {
+		it('chains commands without event Wrappers', () => {
+			const cq = U.newQueue(context, device);
+			const countBefore = cl.getEventHandleCount();
+			
+			const first = cl.enqueueMarker(cq, cl.EVENT_HANDLE);
+			U.assertType(first, 'number');
+			const second = cl.enqueueMarkerWithWaitList(cq, [first], cl.EVENT_HANDLE);
+			assert.strictEqual(cl.getEventHandleCount(), countBefore + 1);
+			
+			cl.waitForEvents([second]);
+			assert.strictEqual(cl.getEventHandleCount(), countBefore);
+			
+			cl.releaseCommandQueue(cq);
+		});
+		
+		it('rejects a consumed handle', () => {
+			const cq = U.newQueue(context, device);
+			const handle = cl.enqueueMarker(cq, cl.EVENT_HANDLE);
+			cl.waitForEvents([handle]);
+			
+			assert.throws(
+				() => cl.waitForEvents([handle]),
+				new Error('Array item #0 is not a live event handle.'),
+			);
+			assert.throws(() => cl.releaseEventHandle(handle), cl.INVALID_EVENT);
+			
+			cl.releaseCommandQueue(cq);
+		});
+		
+		it('keeps the handles of a rejected wait list', () => {
+			const cq = U.newQueue(context, device);
+			const handle = cl.enqueueMarker(cq, cl.EVENT_HANDLE);
+			
+			assert.throws(
+				() => cl.waitForEvents([handle, 'nope' as unknown as number]),
+				new Error('Array item #1 is not an Object.'),
+			);
+			cl.waitForEvents([handle]);
+			
+			cl.releaseCommandQueue(cq);
+		});
+		
+		it('converts a handle into an event', () => {
+			const cq = U.newQueue(context, device);
+			const event = cl.eventFromHandle(cl.enqueueMarker(cq, cl.EVENT_HANDLE));
+			
+			cl.waitForEvents([event]);
+			assert.strictEqual(
+				cl.getEventInfo(event, cl.EVENT_COMMAND_EXECUTION_STATUS),
+				cl.COMPLETE,
+			);
+			
+			cl.releaseEvent(event);
+			cl.releaseCommandQueue(cq);
+		});
+	});
+	
 	describe('#setEventCallback', () => {
 		it('calls cb', (t: TestContext, done: () => void) => {
 			t.plan(2); // plan for 2 assertions in event callback
@@ -5,6 +5,7 @@ import * as cl from './index.ts';
 
 const constants: readonly (keyof typeof cl)[] = [
 	'size_CHAR', 'size_SHORT', 'size_INT', 'size_LONG', 'size_FLOAT', 'size_DOUBLE', 'size_HALF',
+	'EVENT_HANDLE',
 	'DEVICE_NOT_FOUND', 'DEVICE_NOT_AVAILABLE', 'COMPILER_NOT_AVAILABLE',
 	'MEM_OBJECT_ALLOCATION_FAILURE', 'OUT_OF_RESOURCES', 'OUT_OF_HOST_MEMORY',
 	'PROFILING_INFO_NOT_AVAILABLE', 'MEM_COPY_OVERLAP', 'IMAGE_FORMAT_MISMATCH',
@@ -59,11 +60,14 @@ const constants: readonly (keyof typeof cl)[] = [
 	'DEVICE_IMAGE_MAX_BUFFER_SIZE', 'DEVICE_IMAGE_MAX_ARRAY_SIZE', 'DEVICE_PARENT_DEVICE',
 	'DEVICE_PARTITION_MAX_SUB_DEVICES', 'DEVICE_PARTITION_PROPERTIES',
 	'DEVICE_PARTITION_AFFINITY_DOMAIN', 'DEVICE_PARTITION_TYPE', 'DEVICE_REFERENCE_COUNT',
-	'DEVICE_PREFERRED_INTEROP_USER_SYNC', 'DEVICE_PRINTF_BUFFER_SIZE',
+	'DEVICE_PREFERRED_INTEROP_USER_SYNC', 'DEVICE_PRINTF_BUFFER_SIZE', 'DEVICE_SVM_CAPABILITIES',
+	'DEVICE_IL_VERSION',
 	'FP_DENORM', 'FP_INF_NAN', 'FP_ROUND_TO_NEAREST', 'FP_ROUND_TO_ZERO',
 	'FP_ROUND_TO_INF', 'FP_FMA', 'FP_SOFT_FLOAT', 'FP_CORRECTLY_ROUNDED_DIVIDE_SQRT',
 	'NONE', 'READ_ONLY_CACHE', 'READ_WRITE_CACHE', 'LOCAL', 'GLOBAL',
-	'EXEC_KERNEL', 'EXEC_NATIVE_KERNEL', 'QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE',
+	'EXEC_KERNEL', 'EXEC_NATIVE_KERNEL', 'DEVICE_SVM_COARSE_GRAIN_BUFFER',
+	'DEVICE_SVM_FINE_GRAIN_BUFFER', 'DEVICE_SVM_FINE_GRAIN_SYSTEM', 'DEVICE_SVM_ATOMICS',
+	'QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE',
 	'QUEUE_PROFILING_ENABLE', 'CONTEXT_REFERENCE_COUNT', 'CONTEXT_DEVICES',
 	'CONTEXT_PROPERTIES', 'CONTEXT_NUM_DEVICES', 'CONTEXT_PLATFORM',
 	'CONTEXT_INTEROP_USER_SYNC', 'DEVICE_PARTITION_EQUALLY', 'DEVICE_PARTITION_BY_COUNTS',
@@ -74,7 +78,8 @@ const constants: readonly (keyof typeof cl)[] = [
 	'QUEUE_CONTEXT', 'QUEUE_DEVICE', 'QUEUE_REFERENCE_COUNT', 'QUEUE_PROPERTIES',
 	'MEM_READ_WRITE', 'MEM_WRITE_ONLY', 'MEM_READ_ONLY', 'MEM_USE_HOST_PTR',
 	'MEM_ALLOC_HOST_PTR', 'MEM_COPY_HOST_PTR', 'MEM_HOST_WRITE_ONLY',
-	'MEM_HOST_READ_ONLY', 'MEM_HOST_NO_ACCESS', 'MIGRATE_MEM_OBJECT_HOST',
+	'MEM_HOST_READ_ONLY', 'MEM_HOST_NO_ACCESS', 'MEM_SVM_FINE_GRAIN_BUFFER', 'MEM_SVM_ATOMICS',
+	'MIGRATE_MEM_OBJECT_HOST',
 	'MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED', 'R', 'A', 'RG', 'RA', 'RGB', 'RGBA',
 	'BGRA', 'ARGB', 'INTENSITY', 'LUMINANCE', 'Rx', 'RGx', 'RGBx', 'DEPTH',
 	'DEPTH_STENCIL', 'SNORM_INT8', 'SNORM_INT16', 'UNORM_INT8', 'UNORM_INT16',
@@ -93,13 +98,14 @@ const constants: readonly (keyof typeof cl)[] = [
 	'SAMPLER_ADDRESSING_MODE', 'SAMPLER_FILTER_MODE', 'MAP_READ', 'MAP_WRITE',
 	'MAP_WRITE_INVALIDATE_REGION', 'PROGRAM_REFERENCE_COUNT', 'PROGRAM_CONTEXT',
 	'PROGRAM_NUM_DEVICES', 'PROGRAM_DEVICES', 'PROGRAM_SOURCE', 'PROGRAM_BINARY_SIZES',
-	'PROGRAM_BINARIES', 'PROGRAM_NUM_KERNELS', 'PROGRAM_KERNEL_NAMES',
+	'PROGRAM_BINARIES', 'PROGRAM_NUM_KERNELS', 'PROGRAM_KERNEL_NAMES', 'PROGRAM_IL',
 	'PROGRAM_BUILD_STATUS', 'PROGRAM_BUILD_OPTIONS', 'PROGRAM_BUILD_LOG',
 	'PROGRAM_BINARY_TYPE', 'PROGRAM_BINARY_TYPE_NONE',
 	'PROGRAM_BINARY_TYPE_COMPILED_OBJECT', 'PROGRAM_BINARY_TYPE_LIBRARY',
 	'PROGRAM_BINARY_TYPE_EXECUTABLE', 'BUILD_SUCCESS', 'BUILD_NONE', 'BUILD_ERROR',
 	'BUILD_IN_PROGRESS', 'KERNEL_FUNCTION_NAME', 'KERNEL_NUM_ARGS',
 	'KERNEL_REFERENCE_COUNT', 'KERNEL_CONTEXT', 'KERNEL_PROGRAM', 'KERNEL_ATTRIBUTES',
+	'KERNEL_EXEC_INFO_SVM_PTRS', 'KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM',
 	'KERNEL_ARG_ADDRESS_QUALIFIER', 'KERNEL_ARG_ACCESS_QUALIFIER', 'KERNEL_ARG_TYPE_NAME',
 	'KERNEL_ARG_TYPE_QUALIFIER', 'KERNEL_ARG_NAME', 'KERNEL_ARG_ADDRESS_GLOBAL',
 	'KERNEL_ARG_ADDRESS_LOCAL', 'KERNEL_ARG_ADDRESS_CONSTANT',
@@ -131,30 +137,41 @@ const constants: readonly (keyof typeof cl)[] = [
 ];
 
 const methods: readonly (keyof typeof cl)[] = [
-	'createKernel', 'createKernelsInProgram', 'retainKernel', 'releaseKernel',
-	'setKernelArg', 'getKernelInfo', 'getKernelArgInfo', 'getKernelWorkGroupInfo',
-	'createBuffer', 'createSubBuffer', 'createImage', 'retainMemObject',
-	'releaseMemObject', 'getSupportedImageFormats', 'getMemObjectInfo', 'getImageInfo',
+	'setAutoRelease', 'getLiveObjectCounts', 'setObjectTracking', 'getObjectStats',
+	'getLiveObjects',
+	'createKernel', 'cloneKernel', 'createKernelsInProgram', 'retainKernel', 'releaseKernel',
+	'setKernelArg', 'setKernelArgs', 'setKernelArgTypes', 'getKernelInfo', 'getKernelArgInfo',
+	'getKernelWorkGroupInfo',
+	'createBuffer', 'createBufferFromFile', 'createSubBuffer', 'createImage', 'retainMemObject',
+	'releaseMemObject', 'getSupportedImageFormats', 'createPooledBuffer',
+	'releasePooledBuffer', 'trimBufferPool', 'setBufferPoolLimit', 'getBufferPoolStats',
+	'acquireStagingBuffer',
+	'releaseStagingBuffer', 'trimStagingBuffers', 'svmAlloc', 'svmFree',
+	'setKernelArgSVMPointer', 'setKernelExecInfo', 'getMemObjectInfo', 'getImageInfo',
 	'createFromGLBuffer', 'createFromGLRenderbuffer', 'createFromGLTexture',
 	'getPlatformIDs', 'getPlatformInfo', 'createProgramWithSource',
-	'createProgramWithBinary', 'createProgramWithBuiltInKernels', 'retainProgram',
-	'releaseProgram', 'buildProgram', 'compileProgram', 'linkProgram',
+	'createProgramWithBinary', 'createProgramWithIL', 'createProgramWithBuiltInKernels', 'retainProgram',
+	'releaseProgram', 'buildProgram', 'buildProgramAsync', 'compileProgram', 'linkProgram',
 	'unloadPlatformCompiler', 'getProgramInfo', 'getProgramBuildInfo',
 	'retainSampler', 'releaseSampler', 'getSamplerInfo', 'createSampler',
 	'createCommandQueue', 'retainCommandQueue', 'releaseCommandQueue',
-	'getCommandQueueInfo', 'flush', 'finish', 'enqueueReadBuffer',
-	'enqueueReadBufferRect', 'enqueueWriteBuffer', 'enqueueWriteBufferRect',
+	'getCommandQueueInfo', 'flush', 'finish', 'finishAsync', 'enqueueReadBuffer',
+	'enqueueReadBufferAsync', 'enqueueReadBufferRect', 'enqueueWriteBuffer',
+	'enqueueWriteBufferAsync', 'enqueueWriteBufferRect',
 	'enqueueCopyBuffer', 'enqueueCopyBufferRect', 'enqueueReadImage',
-	'enqueueWriteImage', 'enqueueCopyImage', 'enqueueCopyImageToBuffer',
-	'enqueueCopyBufferToImage', 'enqueueMapBuffer', 'enqueueMapImage',
-	'enqueueUnmapMemObject', 'enqueueNDRangeKernel', 'enqueueTask',
+	'enqueueReadImageAsync', 'enqueueWriteImage', 'enqueueWriteImageAsync',
+	'enqueueCopyImage', 'enqueueCopyImageToBuffer', 'enqueueCopyBufferToImage',
+	'enqueueMapBuffer', 'enqueueMapBufferAsync', 'enqueueMapImage', 'enqueueMapImageAsync',
+	'enqueueUnmapMemObject', 'enqueueNDRangeKernel', 'dispatch', 'enqueueTask',
 	'enqueueNativeKernel', 'enqueueMarker', 'enqueueMarkerWithWaitList',
 	'enqueueBarrier', 'enqueueBarrierWithWaitList', 'enqueueFillBuffer',
 	'enqueueFillImage', 'enqueueMigrateMemObjects', 'enqueueAcquireGLObjects',
-	'enqueueReleaseGLObjects', 'createContext', 'createContextFromType',
+	'enqueueReleaseGLObjects', 'enqueueSVMMap', 'enqueueSVMUnmap', 'enqueueSVMMemcpy',
+	'enqueueSVMMemFill', 'createContext', 'createContextFromType',
 	'retainContext', 'releaseContext', 'getContextInfo', 'getDeviceIDs',
 	'getDeviceInfo', 'createSubDevices', 'retainDevice', 'releaseDevice',
-	'waitForEvents', 'getEventInfo', 'createUserEvent', 'retainEvent',
+	'waitForEvents', 'waitForEventsAsync', 'releaseEventHandle', 'eventFromHandle',
+	'getEventHandleCount', 'getEventInfo', 'createUserEvent', 'retainEvent',
 	'releaseEvent', 'setUserEventStatus', 'setEventCallback', 'getEventProfilingInfo',
 ];
 
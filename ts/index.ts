@@ -4,42 +4,115 @@ import { native } from './native.ts';
 import type { TClContext, TClDevice, TClPlatform } from './native.ts';
 
 export type {
+	TArena,
+	TArenaConstructor,
+	TArenaStats,
+	TBufferPoolStats,
 	TBuildProgramCb,
+	TClBuildError,
+	TClBuildLog,
+	TCommandList,
+	TCommandListConstructor,
 	TClContext,
 	TClDevice,
 	TClEvent,
+	TClEventFlag,
+	TClEventHandle,
 	TClEventOrVoid,
+	TClEventResult,
 	TClHostData,
 	TClImageDesc,
 	TClImageFormat,
 	TClKernel,
+	TClLiveObject,
 	TClMem,
 	TClObject,
+	TClObjectStats,
 	TClPlatform,
 	TClProgram,
 	TClQueue,
 	TClSampler,
 	TClSubBufferInfo,
+	TClWaitList,
+	TMapping,
+	TMappingConstructor,
 	TWrapper,
 	TWrapperConstructor,
 } from './native.ts';
 
+export { createBinaryCache } from './binary-cache.ts';
+export type { TBinaryCache, TBinaryCacheOptions, TBinaryCacheStats } from './binary-cache.ts';
+export { createKernelPool } from './kernel-pool.ts';
+export type { TKernelPool, TKernelPoolOptions, TKernelPoolStats } from './kernel-pool.ts';
+export { createKernelVariants } from './kernel-variants.ts';
+export type {
+	TKernelVariant,
+	TKernelVariants,
+	TKernelVariantsOptions,
+	TKernelVariantsStats,
+	TVariantParams,
+	TVariantValue,
+} from './kernel-variants.ts';
+export { createMemoryBudget } from './memory-budget.ts';
+export type {
+	TManagedBuffer,
+	TMemoryBudget,
+	TMemoryBudgetOptions,
+	TMemoryBudgetStats,
+	TMemoryLease,
+} from './memory-budget.ts';
+export {
+	packProgramBundle,
+	readProgramBundle,
+	unpackProgramBundle,
+	writeProgramBundle,
+} from './program-bundle.ts';
+export type { TBundledProgram } from './program-bundle.ts';
+export { createProgramCache, programCache } from './program-cache.ts';
+export type { TProgramCache, TProgramCacheStats } from './program-cache.ts';
+export { streamCompute } from './stream.ts';
+export type { TStreamChunk, TStreamOptions } from './stream.ts';
+
 export const {
 	Wrapper,
+	CommandList,
+	Arena,
+	Mapping,
+	setAutoRelease,
+	getLiveObjectCounts,
+	setObjectTracking,
+	getObjectStats,
+	getLiveObjects,
 	createKernel,
+	cloneKernel,
 	createKernelsInProgram,
 	retainKernel,
 	releaseKernel,
 	setKernelArg,
+	setKernelArgs,
+	setKernelArgTypes,
 	getKernelInfo,
 	getKernelArgInfo,
 	getKernelWorkGroupInfo,
 	createBuffer,
+	createBufferFromFile,
 	createSubBuffer,
 	createImage,
 	retainMemObject,
 	releaseMemObject,
 	getSupportedImageFormats,
+	createPooledBuffer,
+	releasePooledBuffer,
+	trimBufferPool,
+	setBufferPoolLimit,
+	getBufferPoolStats,
+	acquireStagingBuffer,
+	releaseStagingBuffer,
+	trimStagingBuffers,
+	svmAlloc,
+	svmFree,
+	setKernelArgSVMPointer,
+	setKernelExecInfo,
 	getMemObjectInfo,
 	getImageInfo,
 	createFromGLBuffer,
@@ -50,10 +123,12 @@ export const {
 	createProgram,
 	createProgramWithSource,
 	createProgramWithBinary,
+	createProgramWithIL,
 	createProgramWithBuiltInKernels,
 	retainProgram,
 	releaseProgram,
 	buildProgram,
+	buildProgramAsync,
 	compileProgram,
 	linkProgram,
 	unloadPlatformCompiler,
@@ -69,21 +144,29 @@ export const {
 	getCommandQueueInfo,
 	flush,
 	finish,
+	finishAsync,
 	enqueueReadBuffer,
+	enqueueReadBufferAsync,
 	enqueueReadBufferRect,
 	enqueueWriteBuffer,
+	enqueueWriteBufferAsync,
 	enqueueWriteBufferRect,
 	enqueueCopyBuffer,
 	enqueueCopyBufferRect,
 	enqueueReadImage,
+	enqueueReadImageAsync,
 	enqueueWriteImage,
+	enqueueWriteImageAsync,
 	enqueueCopyImage,
 	enqueueCopyImageToBuffer,
 	enqueueCopyBufferToImage,
 	enqueueMapBuffer,
+	enqueueMapBufferAsync,
 	enqueueMapImage,
+	enqueueMapImageAsync,
 	enqueueUnmapMemObject,
 	enqueueNDRangeKernel,
+	dispatch,
 	enqueueTask,
 	enqueueNativeKernel,
 	enqueueMarker,
@@ -95,6 +178,10 @@ export const {
 	enqueueMigrateMemObjects,
 	enqueueAcquireGLObjects,
 	enqueueReleaseGLObjects,
+	enqueueSVMMap,
+	enqueueSVMUnmap,
+	enqueueSVMMemcpy,
+	enqueueSVMMemFill,
 	createContext,
 	createContextFromType,
 	retainContext,
@@ -106,6 +193,10 @@ export const {
 	retainDevice,
 	releaseDevice,
 	waitForEvents,
+	waitForEventsAsync,
+	releaseEventHandle,
+	eventFromHandle,
+	getEventHandleCount,
 	getEventInfo,
 	createUserEvent,
 	retainEvent,
@@ -120,6 +211,7 @@ export const {
 	size_FLOAT,
 	size_DOUBLE,
 	size_HALF,
+	EVENT_HANDLE,
 	SUCCESS,
 	VERSION_1_0,
 	VERSION_1_1,
@@ -213,6 +305,8 @@ export const {
 	DEVICE_REFERENCE_COUNT,
 	DEVICE_PREFERRED_INTEROP_USER_SYNC,
 	DEVICE_PRINTF_BUFFER_SIZE,
+	DEVICE_SVM_CAPABILITIES,
+	DEVICE_IL_VERSION,
 	FP_DENORM,
 	FP_INF_NAN,
 	FP_ROUND_TO_NEAREST,
@@ -228,6 +322,10 @@ export const {
 	GLOBAL,
 	EXEC_KERNEL,
 	EXEC_NATIVE_KERNEL,
+	DEVICE_SVM_COARSE_GRAIN_BUFFER,
+	DEVICE_SVM_FINE_GRAIN_BUFFER,
+	DEVICE_SVM_FINE_GRAIN_SYSTEM,
+	DEVICE_SVM_ATOMICS,
 	QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE,
 	QUEUE_PROFILING_ENABLE,
 	CONTEXT_REFERENCE_COUNT,
@@ -259,6 +357,8 @@ export const {
 	MEM_HOST_WRITE_ONLY,
 	MEM_HOST_READ_ONLY,
 	MEM_HOST_NO_ACCESS,
+	MEM_SVM_FINE_GRAIN_BUFFER,
+	MEM_SVM_ATOMICS,
 	MIGRATE_MEM_OBJECT_HOST,
 	MIGRATE_MEM_OBJECT_CONTENT_UNDEFINED,
 	R,
@@ -342,6 +442,7 @@ export const {
 	PROGRAM_BINARIES,
 	PROGRAM_NUM_KERNELS,
 	PROGRAM_KERNEL_NAMES,
+	PROGRAM_IL,
 	PROGRAM_BUILD_STATUS,
 	PROGRAM_BUILD_OPTIONS,
 	PROGRAM_BUILD_LOG,
@@ -360,6 +461,8 @@ export const {
 	KERNEL_CONTEXT,
 	KERNEL_PROGRAM,
 	KERNEL_ATTRIBUTES,
+	KERNEL_EXEC_INFO_SVM_PTRS,
+	KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM,
 	KERNEL_ARG_ADDRESS_QUALIFIER,
 	KERNEL_ARG_ACCESS_QUALIFIER,
 	KERNEL_ARG_TYPE_NAME,
@@ -503,6 +606,16 @@ Object.defineProperty(Wrapper.prototype, inspect.custom, {
 	configurable: true,
 });
 
+Object.defineProperty(Wrapper.prototype, Symbol.dispose, {
+	value: Wrapper.prototype.dispose,
+	configurable: true,
+});
+
+Object.defineProperty(Mapping.prototype, Symbol.dispose, {
+	value: Mapping.prototype.unmap,
+	configurable: true,
+});
+
 const logger = getLogger('opencl');
 
 type TDeviceCandidate = Readonly<{
@@ -0,0 +1,77 @@
+import fs from 'node:fs';
+import { strict as assert } from 'node:assert';
+import { describe, it, after } from 'node:test';
+import * as cl from './index.ts';
+import * as U from './utils.ts';
+
+const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
+
+
+describe('KernelPool', () => {
+	const { context, device } = cl.quickStart();
+	const queue = U.newQueue(context, device);
+	const program = cl.createProgramWithSource(context, squareKern);
+	cl.buildProgram(program, null, '-cl-kernel-arg-info');
+	
+	after(() => {
+		cl.releaseProgram(program);
+		cl.releaseCommandQueue(queue);
+	});
+	
+	describe('#createKernelPool', () => {
+		it('hands out a kernel per user', () => {
+			const pool = cl.createKernelPool(program, 'square');
+			const a = pool.acquire();
+			const b = pool.acquire();
+			assert.notStrictEqual(a, b);
+			assert.deepStrictEqual(pool.getStats(), { busy: 2, idle: 0, created: 2, reused: 0 });
+			
+			pool.release(a);
+			assert.strictEqual(pool.acquire(), a);
+			assert.deepStrictEqual(pool.getStats(), { busy: 2, idle: 0, created: 2, reused: 1 });
+			
+			pool.release(a);
+			pool.release(b);
+			pool.dispose();
+			assert.throws(() => pool.acquire(), new Error('The kernel pool is disposed.'));
+		});
+		
+		it('keeps the args of each kernel apart', () => {
+			const pool = cl.createKernelPool(program, 'square');
+			const inputs = [new Float32Array([1, 2, 3, 4]), new Float32Array([5, 6, 7, 8])];
+			const jobs = inputs.map((input) => ({
+				kernel: pool.acquire(),
+				inputMem: cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, input),
+				outputMem: cl.createBuffer(context, cl.MEM_WRITE_ONLY, 16, null),
+			}));
+			
+			// Both kernels are set up before either is enqueued
+			for (const { kernel, inputMem, outputMem } of jobs) {
+				cl.setKernelArgs(kernel, [inputMem, outputMem, 4]);
+			}
+			for (const { kernel } of jobs) {
+				cl.enqueueNDRangeKernel(queue, kernel, 1, null, [4]);
+			}
+			
+			const results = jobs.map(({ kernel, inputMem, outputMem }) => {
+				const output = new Float32Array(4);
+				cl.enqueueReadBuffer(queue, outputMem, true, 0, 16, output);
+				cl.releaseMemObject(inputMem);
+				cl.releaseMemObject(outputMem);
+				pool.release(kernel);
+				return Array.from(output);
+			});
+			
+			assert.deepStrictEqual(results, [[1, 4, 9, 16], [25, 36, 49, 64]]);
+			pool.dispose();
+		});
+		
+		it('throws on a foreign kernel', () => {
+			const pool = cl.createKernelPool(program, 'square');
+			const kernel = cl.createKernel(program, 'square');
+			assert.throws(() => pool.release(kernel), new Error('The kernel is not from this pool.'));
+			cl.releaseKernel(kernel);
+			pool.dispose();
+		});
+	});
+});
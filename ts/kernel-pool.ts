@@ -0,0 +1,102 @@
+import { native } from './native.ts';
+import type { TClKernel, TClProgram } from './native.ts';
+
+const {
+	createKernel,
+	cloneKernel,
+	releaseKernel,
+} = native;
+
+export type TKernelPoolOptions = Readonly<{
+	/** How many returned kernels are kept for reuse. 16 by default. */
+	maxIdle?: number;
+}>;
+
+export type TKernelPoolStats = Readonly<{
+	/** Kernels handed out and not yet returned. */
+	busy: number;
+	idle: number;
+	/** Kernels created over the pool life. */
+	created: number;
+	/** Acquired kernels that were taken from the idle ones. */
+	reused: number;
+}>;
+
+export type TKernelPool = {
+	readonly name: string;
+	/**
+	 * Get a kernel that no one else uses until it is returned by `release()`.
+	 * Its args may have the values of its previous user.
+	*/
+	acquire: () => TClKernel;
+	release: (kernel: TClKernel) => void;
+	getStats: () => TKernelPoolStats;
+	/** Release the idle kernels. The busy ones are released when returned. */
+	dispose: () => void;
+};
+
+/**
+ * Kernels of one function of `program`, for concurrent users.
+ *
+ * A kernel keeps the values of its args, so one kernel can't be set up by two
+ * pipelines at once. Each user of the pool owns its kernel until it's returned.
+ * The kernels are cloned from the first one, see `cloneKernel()`.
+*/
+export const createKernelPool = (
+	program: TClProgram, name: string, options: TKernelPoolOptions = {},
+): TKernelPool => {
+	const { maxIdle = 16 } = options;
+	
+	const template = createKernel(program, name);
+	const idle: TClKernel[] = [];
+	const busy = new Set<TClKernel>();
+	let created = 0;
+	let reused = 0;
+	let isDisposed = false;
+	
+	return {
+		name,
+		
+		acquire: (): TClKernel => {
+			if (isDisposed) {
+				throw new Error('The kernel pool is disposed.');
+			}
+			
+			let kernel = idle.pop();
+			if (kernel) {
+				reused++;
+			} else {
+				kernel = cloneKernel(template);
+				created++;
+			}
+			
+			busy.add(kernel);
+			return kernel;
+		},
+		
+		release: (kernel): void => {
+			if (!busy.delete(kernel)) {
+				throw new Error('The kernel is not from this pool.');
+			}
+			if (isDisposed || idle.length >= maxIdle) {
+				releaseKernel(kernel);
+				return;
+			}
+			idle.push(kernel);
+		},
+		
+		getStats: (): TKernelPoolStats => ({ busy: busy.size, idle: idle.length, created, reused }),
+		
+		dispose: (): void => {
+			if (isDisposed) {
+				return;
+			}
+			isDisposed = true;
+			for (const kernel of idle) {
+				releaseKernel(kernel);
+			}
+			idle.length = 0;
+			releaseKernel(template);
+		},
+	};
+};
@@ -0,0 +1,137 @@
+import fs from 'node:fs';
+import { strict as assert } from 'node:assert';
+import { describe, it, after } from 'node:test';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import * as cl from './index.ts';
+import * as U from './utils.ts';
+
+const scaleKern = `
+	__kernel void scale(__global float *data) {
+		uint i = get_global_id(0);
+		data[i] = data[i] * FACTOR + (USE_BIAS ? 1.0f : 0.0f);
+	}
+`;
+
+
+describe('KernelVariants', () => {
+	const { context, device } = cl.quickStart();
+	const queue = U.newQueue(context, device);
+	const dir = fs.mkdtempSync(join(tmpdir(), 'opencl-variants-'));
+	
+	after(() => {
+		cl.releaseCommandQueue(queue);
+		fs.rmSync(dir, { recursive: true, force: true });
+	});
+	
+	const run = (kernel: cl.TClKernel): number[] => {
+		const data = new Float32Array([1, 2, 3, 4]);
+		const mem = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, data);
+		// Programs from binaries may have no arg info
+		cl.setKernelArg(kernel, 0, 'float*', mem);
+		cl.enqueueNDRangeKernel(queue, kernel, 1, null, [4]);
+		cl.enqueueReadBuffer(queue, mem, true, 0, 16, data);
+		cl.releaseMemObject(mem);
+		return Array.from(data);
+	};
+	
+	describe('#createKernelVariants', () => {
+		it('builds each set of values once', () => {
+			const variants = cl.createKernelVariants({
+				context, source: scaleKern, schema: { FACTOR: [2, 3], USE_BIAS: null },
+			});
+			
+			const double = variants.get({ FACTOR: 2, USE_BIAS: false });
+			assert.deepStrictEqual(run(double.kernel('scale')), [2, 4, 6, 8]);
+			assert.deepStrictEqual(run(variants.get({ FACTOR: 3, USE_BIAS: true }).kernel('scale')), [4, 7, 10, 13]);
+			
+			assert.strictEqual(variants.get({ USE_BIAS: false, FACTOR: 2 }), double);
+			assert.strictEqual(double.kernel('scale'), double.kernel('scale'));
+			assert.deepStrictEqual(variants.getStats(), { variants: 2, builds: 2, hits: 1 });
+			
+			variants.dispose();
+		});
+		
+		it('validates the params', () => {
+			const variants = cl.createKernelVariants({
+				context, source: scaleKern, schema: { FACTOR: [2, 3], USE_BIAS: null },
+			});
+			
+			assert.throws(
+				() => variants.get({ FACTOR: 4, USE_BIAS: 0 }),
+				new Error('Value 4 is not allowed for variant param "FACTOR".'),
+			);
+			assert.throws(
+				() => variants.get({ FACTOR: 2 }),
+				new Error('Missing variant param "USE_BIAS".'),
+			);
+			assert.throws(
+				() => variants.get({ FACTOR: 2, USE_BIAS: 0, TILE: 8 }),
+				new Error('Unknown variant param "TILE".'),
+			);
+			assert.throws(
+				() => variants.get({ FACTOR: 2, USE_BIAS: '0 -D X' }),
+				new Error('Invalid value of variant param "USE_BIAS": 0 -D X'),
+			);
+			
+			variants.dispose();
+		});
+		
+		it('shares a pending async build', async () => {
+			const variants = cl.createKernelVariants({
+				context, source: scaleKern, schema: { FACTOR: null, USE_BIAS: null },
+			});
+			
+			const [a, b] = await Promise.all([
+				variants.getAsync({ FACTOR: 5, USE_BIAS: 0 }),
+				variants.getAsync({ FACTOR: 5, USE_BIAS: 0 }),
+			]);
+			assert.strictEqual(a, b);
+			assert.deepStrictEqual(run(a.kernel('scale')), [5, 10, 15, 20]);
+			assert.strictEqual(variants.getStats().builds, 1);
+			
+			variants.dispose();
+		});
+		
+		it('keeps one variant when get() overtakes getAsync()', async () => {
+			const variants = cl.createKernelVariants({
+				context, source: scaleKern, schema: { FACTOR: null, USE_BIAS: null },
+			});
+			
+			const building = variants.getAsync({ FACTOR: 6, USE_BIAS: 0 });
+			const built = variants.get({ FACTOR: 6, USE_BIAS: 0 });
+			assert.strictEqual(await building, built);
+			assert.strictEqual(variants.getStats().variants, 1);
+			assert.strictEqual(variants.getStats().builds, 1);
+			
+			variants.dispose();
+		});
+		
+		it('forgets a failed async build', async () => {
+			// A malformed source throws before the build starts
+			const variants = cl.createKernelVariants({
+				context, source: null as unknown as string, schema: {},
+			});
+			await assert.rejects(variants.getAsync({}));
+			await assert.rejects(variants.getAsync({}));
+			assert.strictEqual(variants.getStats().hits, 0);
+			variants.dispose();
+		});
+		
+		it('keeps the binaries in a binary cache', () => {
+			const binaryCache = cl.createBinaryCache({ dir });
+			const options = { context, source: scaleKern, schema: { FACTOR: null, USE_BIAS: null }, binaryCache, device };
+			const params = { FACTOR: 2, USE_BIAS: 1 };
+			
+			const first = cl.createKernelVariants(options);
+			first.get(params);
+			first.dispose();
+			
+			const variants = cl.createKernelVariants(options);
+			assert.deepStrictEqual(run(variants.get(params).kernel('scale')), [3, 5, 7, 9]);
+			assert.strictEqual(binaryCache.getStats().hits, 1);
+			
+			variants.dispose();
+		});
+	});
+});
@@ -0,0 +1,229 @@
+import { native } from './native.ts';
+import type { TClContext, TClDevice, TClKernel, TClProgram } from './native.ts';
+import type { TBinaryCache } from './binary-cache.ts';
+
+const {
+	createProgramWithSource,
+	buildProgram,
+	buildProgramAsync,
+	releaseProgram,
+	createKernel,
+	releaseKernel,
+} = native;
+
+export type TVariantValue = number | boolean | string;
+export type TVariantParams = Readonly<Record<string, TVariantValue>>;
+
+export type TKernelVariantsOptions = Readonly<{
+	context: TClContext;
+	source: string;
+	/**
+	 * The compile-time parameters, each becomes a `-D NAME=value` option.
+	 * Either the allowed values, or `null` for any value.
+	*/
+	schema: Readonly<Record<string, readonly TVariantValue[] | null>>;
+	/** Used by all variants, e.g. `-cl-fast-relaxed-math`. */
+	options?: string;
+	/** Keep the variant binaries on disk, requires a `device`. */
+	binaryCache?: TBinaryCache;
+	/** Build all variants for this device only. By default, for all devices of `context`. */
+	device?: TClDevice;
+}>;
+
+export type TKernelVariant = {
+	readonly params: TVariantParams;
+	readonly program: TClProgram;
+	/** The kernel `name` of this variant, created once. */
+	kernel: (name: string) => TClKernel;
+};
+
+export type TKernelVariantsStats = Readonly<{
+	variants: number;
+	builds: number;
+	hits: number;
+}>;
+
+export type TKernelVariants = {
+	/** Get the variant for `params`, built on first use. */
+	get: (params: TVariantParams) => TKernelVariant;
+	/** Same as `get()`, but the build doesn't block the JS thread. */
+	getAsync: (params: TVariantParams) => Promise<TKernelVariant>;
+	getStats: () => TKernelVariantsStats;
+	/** Release all programs and kernels of the variants. */
+	dispose: () => void;
+};
+
+// Only plain tokens, a value can't sneak in other build options
+const VALUE_REGEX = /^[\w.+-]+$/;
+
+const toDefine = (name: string, value: TVariantValue): string => {
+	const text = typeof value === 'boolean' ? String(Number(value)) : String(value);
+	if (!VALUE_REGEX.test(text)) {
+		throw new Error(`Invalid value of variant param "${name}": ${text}`);
+	}
+	return `-D ${name}=${text}`;
+};
+
+/**
+ * Compile-time variants of one source, selected by param values.
+ *
+ * The params are passed as `-D` defines, so the compiler folds them as constants.
+ * A variant is built once per distinct set of values, and kept until `dispose()`.
+*/
+export const createKernelVariants = (opts: TKernelVariantsOptions): TKernelVariants => {
+	const { context, source, schema, options = '', binaryCache, device } = opts;
+	if (binaryCache && !device) {
+		throw new Error('A device is required for the binary cache.');
+	}
+	
+	const names = Object.keys(schema).toSorted();
+	// `get()` and `getAsync()` build for the same devices, so either may fill a key
+	const devices = device ? [device] : null;
+	const variants = new Map<string, TKernelVariant>();
+	const disposers = new Map<string, () => void>();
+	const pending = new Map<string, Promise<TKernelVariant>>();
+	let builds = 0;
+	let hits = 0;
+	let isDisposed = false;
+	
+	// The build options of a variant are also its key
+	const getBuildOptions = (params: TVariantParams): string => {
+		for (const name of Object.keys(params)) {
+			if (!(name in schema)) {
+				throw new Error(`Unknown variant param "${name}".`);
+			}
+		}
+		
+		const defines = names.map((name) => {
+			const value = params[name];
+			if (value === undefined) {
+				throw new Error(`Missing variant param "${name}".`);
+			}
+			const allowed = schema[name];
+			if (allowed && !allowed.includes(value)) {
+				throw new Error(`Value ${String(value)} is not allowed for variant param "${name}".`);
+			}
+			return toDefine(name, value);
+		});
+		
+		return [...defines, options].filter(Boolean).join(' ');
+	};
+	
+	const addVariant = (key: string, params: TVariantParams, program: TClProgram): TKernelVariant => {
+		// `get()` may have built the same variant while `getAsync()` was building
+		const existing = variants.get(key);
+		if (existing) {
+			releaseProgram(program);
+			hits++;
+			return existing;
+		}
+		
+		const kernels = new Map<string, TClKernel>();
+		const variant: TKernelVariant = {
+			params: { ...params },
+			program,
+			kernel: (name): TClKernel => {
+				let kernel = kernels.get(name);
+				if (!kernel) {
+					kernel = createKernel(program, name);
+					kernels.set(name, kernel);
+				}
+				return kernel;
+			},
+		};
+		
+		disposers.set(key, () => {
+			kernels.forEach((kernel) => releaseKernel(kernel));
+			releaseProgram(program);
+		});
+		variants.set(key, variant);
+		builds++;
+		return variant;
+	};
+	
+	const checkDisposed = (): void => {
+		if (isDisposed) {
+			throw new Error('The kernel variants are disposed.');
+		}
+	};
+	
+	const get = (params: TVariantParams): TKernelVariant => {
+		checkDisposed();
+		const key = getBuildOptions(params);
+		const cached = variants.get(key);
+		if (cached) {
+			hits++;
+			return cached;
+		}
+		
+		if (binaryCache && device) {
+			return addVariant(key, params, binaryCache.build(context, device, source, key));
+		}
+		
+		const program = createProgramWithSource(context, source);
+		try {
+			buildProgram(program, devices, key);
+		} catch (error) {
+			releaseProgram(program);
+			throw error;
+		}
+		return addVariant(key, params, program);
+	};
+	
+	return {
+		get,
+		
+		getAsync: async (params): Promise<TKernelVariant> => {
+			checkDisposed();
+			// The binary cache is synchronous, and mostly skips the compiler anyway
+			if (binaryCache) {
+				return get(params);
+			}
+			
+			const key = getBuildOptions(params);
+			const cached = variants.get(key);
+			if (cached) {
+				hits++;
+				return cached;
+			}
+			
+			// Concurrent calls for the same variant share one build
+			const building = pending.get(key);
+			if (building) {
+				hits++;
+				return building;
+			}
+			
+			const buildVariant = async (): Promise<TKernelVariant> => {
+				const program = createProgramWithSource(context, source);
+				try {
+					await buildProgramAsync(program, devices, key);
+				} catch (error) {
+					releaseProgram(program);
+					throw error;
+				} finally {
+					pending.delete(key);
+				}
+				if (isDisposed) {
+					releaseProgram(program);
+					throw new Error('The kernel variants are disposed.');
+				}
+				return addVariant(key, params, program);
+			};
+			
+			// Starts after `pending.set()`, even if it throws right away
+			const build = Promise.resolve().then(buildVariant);
+			pending.set(key, build);
+			return build;
+		},
+		
+		getStats: (): TKernelVariantsStats => ({ variants: variants.size, builds, hits }),
+		
+		dispose: (): void => {
+			isDisposed = true;
+			disposers.forEach((dispose) => dispose());
+			disposers.clear();
+			variants.clear();
+		},
+	};
+};
@@ -6,6 +6,11 @@ import * as U from './utils.ts';
 
 const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
 const squareCpyKern = fs.readFileSync(new URL('../examples/assets/kernels/square_cpy.cl', import.meta.url)).toString();
+const vectorKern = `
+	__kernel void vectors(float3 a, uint4 b, int16 c, __global float *out) {
+		out[0] = a.x + (float)b.x + (float)c.s0;
+	}
+`;
 
 
 describe('Kernel', () => {
@@ -29,6 +34,34 @@ describe('Kernel', () => {
 		});
 	});
 	
+	describe('#cloneKernel', () => {
+		it('returns a kernel of the same function', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const k = cl.createKernel(prg, 'square');
+				const clone = cl.cloneKernel(k);
+				assert.notStrictEqual(clone, k);
+				assert.strictEqual(cl.getKernelInfo(clone, cl.KERNEL_FUNCTION_NAME), 'square');
+				cl.releaseKernel(clone);
+				cl.releaseKernel(k);
+			});
+		});
+	});
+	
+	describe('#setKernelArgTypes', () => {
+		it('returns the number of known types', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const k = cl.createKernel(prg, 'square');
+				assert.strictEqual(cl.setKernelArgTypes(k, ['float*', null, 'image2d_t']), 1);
+				assert.strictEqual(cl.setKernelArgTypes(k, ['float*', 'float*', 'uint']), 3);
+				assert.throws(
+					() => cl.setKernelArgTypes(k, [1]),
+					new Error('Array item #0 must be of type `String`'),
+				);
+				cl.releaseKernel(k);
+			});
+		});
+	});
+	
 	describe('#createKernelsInProgram', () => {
 		it('returns two valid kernels', () => {
 			U.withProgram(context, [squareKern, squareCpyKern].join('\n'), (prg) => {
@@ -138,6 +171,29 @@ describe('Kernel', () => {
 			});
 		});
 		
+		it('reuses the introspected signature on repeated calls', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const k = cl.createKernel(prg, 'square');
+				const mem = cl.createBuffer(context, 0, 8, null);
+				
+				for (let i = 0; i < 3; i++) {
+					assert.strictEqual(cl.setKernelArg(k, 0, null, mem), cl.SUCCESS);
+					assert.strictEqual(cl.setKernelArg(k, 2, null, i), cl.SUCCESS);
+				}
+				assert.throws(
+					() => cl.setKernelArg(k, 2, null, 'a'),
+					cl.INVALID_ARG_VALUE,
+				);
+				assert.throws(
+					() => cl.setKernelArg(k, 0, null, 5),
+					new Error('Argument 3 must be of type `Object`'),
+				);
+				
+				cl.releaseMemObject(mem);
+				cl.releaseKernel(k);
+			});
+		});
+		
 		it('fails when passed a char as third argument (expected : integer)', () => {
 			U.withProgram(context, squareKern, (prg) => {
 				const k = cl.createKernel(prg, 'square');
@@ -204,8 +260,96 @@ describe('Kernel', () => {
 				cl.releaseKernel(k);
 			});
 		});
+		
+		it('accepts vector arguments, including 3-component ones', () => {
+			U.withProgram(context, vectorKern, (prg) => {
+				const k = cl.createKernel(prg, 'vectors');
+				
+				assert.strictEqual(cl.setKernelArg(k, 0, null, [1, 2, 3]), cl.SUCCESS);
+				assert.strictEqual(cl.setKernelArg(k, 0, 'float3', [1, 2, 3]), cl.SUCCESS);
+				assert.strictEqual(cl.setKernelArg(k, 1, null, [1, 2, 3, 4]), cl.SUCCESS);
+				assert.strictEqual(
+					cl.setKernelArg(k, 2, 'int16', Array.from({ length: 16 }, (_v, i) => i)),
+					cl.SUCCESS,
+				);
+				assert.throws(
+					() => cl.setKernelArg(k, 1, null, [1, 2, 3]),
+					cl.INVALID_ARG_SIZE,
+				);
+				
+				cl.releaseKernel(k);
+			});
+		});
 	});
 
+	describe('#setKernelArgs', () => {
+		it('sets all arguments in one call', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const k = cl.createKernel(prg, 'square');
+				const mem = cl.createBuffer(context, 0, 8, null);
+				
+				assert.strictEqual(cl.setKernelArgs(k, [mem, mem, 5]), cl.SUCCESS);
+				assert.strictEqual(
+					cl.setKernelArgs(k, [mem, mem, 5], ['float*', null, 'uint']),
+					cl.SUCCESS,
+				);
+				
+				cl.releaseMemObject(mem);
+				cl.releaseKernel(k);
+			});
+		});
+		
+		it('reports the index of an invalid argument', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const k = cl.createKernel(prg, 'square');
+				const mem = cl.createBuffer(context, 0, 8, null);
+				
+				assert.throws(
+					() => cl.setKernelArgs(k, [mem, 5, 5]),
+					new Error('Array item #1 must be of type `Object`'),
+				);
+				assert.throws(
+					() => cl.setKernelArgs(k, [mem, mem, 'a']),
+					new Error('Array item #2 failed: Invalid argument value'),
+				);
+				assert.throws(
+					() => cl.setKernelArgs(k, [mem, mem, 5, 5]),
+					/Array item #3 failed/,
+				);
+				
+				cl.releaseMemObject(mem);
+				cl.releaseKernel(k);
+			});
+		});
+		
+		it('leaves the arguments as they were if one is invalid', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const k = cl.createKernel(prg, 'square');
+				const cq = U.newQueue(context, device);
+				const input = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, new Float32Array([1, 2, 3, 4]));
+				const output = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, new Float32Array(4));
+				const other = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, new Float32Array(4));
+				
+				cl.setKernelArgs(k, [input, output, 4]);
+				assert.throws(
+					() => cl.setKernelArgs(k, [input, other, 'a']),
+					new Error('Array item #2 failed: Invalid argument value'),
+				);
+				cl.enqueueNDRangeKernel(cq, k, 1, null, [4]);
+				
+				const result = new Float32Array(4);
+				cl.enqueueReadBuffer(cq, output, true, 0, 16, result);
+				assert.deepStrictEqual(Array.from(result), [1, 4, 9, 16]);
+				cl.enqueueReadBuffer(cq, other, true, 0, 16, result);
+				assert.deepStrictEqual(Array.from(result), [0, 0, 0, 0]);
+				
+				[input, output, other].forEach((mem) => cl.releaseMemObject(mem));
+				cl.releaseCommandQueue(cq);
+				cl.releaseKernel(k);
+			});
+		});
+	});
+	
 	describe('#getKernelInfo', () => {
 		const testForType = (key: keyof typeof cl, _assert: (v: unknown) => void) => {
 			it(`returns the good type for ${key}`, () => {
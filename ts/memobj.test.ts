@@ -1,10 +1,13 @@
 import { strict as assert } from 'node:assert';
+import { mkdtempSync, rmSync, writeFileSync } from 'node:fs';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
 import { describe, it, after } from 'node:test';
 import * as cl from './index.ts';
 
 
 describe('MemObj', () => {
-	const { context } = cl.quickStart();
+	const { context, device } = cl.quickStart();
 	const buffer = cl.createBuffer(context, 0, 8);
 	
 	after(() => {
@@ -87,6 +90,54 @@ describe('MemObj', () => {
 		});
 	});
 	
+	describe('#createBufferFromFile', () => {
+		const dir = mkdtempSync(join(tmpdir(), 'opencl-'));
+		const path = join(dir, 'data.bin');
+		writeFileSync(path, Uint8Array.from({ length: 10000 }, (_v, i) => i % 251));
+		const cq = cl.createCommandQueue(context, device);
+		
+		after(() => {
+			cl.releaseCommandQueue(cq);
+			rmSync(dir, { recursive: true });
+		});
+		
+		it('maps a file region', () => {
+			const mem = cl.createBufferFromFile(context, path, cl.MEM_READ_ONLY, { offset: 5000, length: 100 });
+			assert.strictEqual(cl.getMemObjectInfo(mem, cl.MEM_SIZE), 100);
+			
+			const out = Buffer.alloc(100);
+			cl.enqueueReadBuffer(cq, mem, true, 0, 100, out);
+			assert.strictEqual(out[0], 5000 % 251);
+			cl.releaseMemObject(mem);
+		});
+		
+		it('copies the whole file', () => {
+			const mem = cl.createBufferFromFile(context, path, cl.MEM_COPY_HOST_PTR);
+			assert.strictEqual(cl.getMemObjectInfo(mem, cl.MEM_SIZE), 10000);
+			cl.releaseMemObject(mem);
+		});
+		
+		it('throws if the range is out of bounds', () => {
+			assert.throws(
+				() => cl.createBufferFromFile(context, path, 0, { offset: 20000 }),
+				new Error(`The range is out of the file bounds. ${path}`),
+			);
+		});
+		
+		it('throws if the range is not made of non-negative integers', () => {
+			for (const offset of [-1, NaN, Infinity, 0.5, '1']) {
+				assert.throws(
+					() => cl.createBufferFromFile(context, path, 0, { offset: offset as number }),
+					new Error('Argument 3 `offset` must be a non-negative integer.'),
+				);
+			}
+			assert.throws(
+				() => cl.createBufferFromFile(context, path, 0, { length: -100 }),
+				new Error('Argument 3 `length` must be a non-negative integer.'),
+			);
+		});
+	});
+	
 	describe('#createSubBuffer', () => {
 		it('throws if buffer is not valid', () => {
 			assert.throws(
@@ -348,4 +399,204 @@ describe('MemObj', () => {
 			);
 		});
 	});
+	
+	describe('#setAutoRelease', () => {
+		const countMems = (): number => cl.getLiveObjectCounts().cl_mem ?? 0;
+		
+		it('tracks the references of auto-released wrappers', () => {
+			cl.setAutoRelease(true);
+			try {
+				const countBefore = countMems();
+				const buffer = cl.createBuffer(context, 0, 8);
+				assert.strictEqual(countMems(), countBefore + 1);
+				
+				cl.retainMemObject(buffer);
+				cl.releaseMemObject(buffer);
+				assert.strictEqual(countMems(), countBefore + 1);
+				
+				buffer[Symbol.dispose]();
+				assert.strictEqual(countMems(), countBefore);
+			} finally {
+				cl.setAutoRelease(false);
+			}
+		});
+		
+		it('does not release an auto-released wrapper twice', () => {
+			cl.setAutoRelease(true);
+			try {
+				const buffer = cl.createBuffer(context, 0, 8);
+				cl.releaseMemObject(buffer);
+				assert.throws(() => cl.releaseMemObject(buffer), cl.INVALID_MEM_OBJECT);
+			} finally {
+				cl.setAutoRelease(false);
+			}
+		});
+		
+		it('does not track manual wrappers', () => {
+			const countBefore = countMems();
+			const buffer = cl.createBuffer(context, 0, 8);
+			assert.strictEqual(countMems(), countBefore);
+			buffer.dispose();
+		});
+	});
+	
+	describe('#createPooledBuffer', () => {
+		it('reuses a released buffer of the same class', () => {
+			cl.trimBufferPool();
+			const first = cl.createPooledBuffer(context, cl.MEM_READ_WRITE, 1000);
+			assert.strictEqual(cl.getMemObjectInfo(first, cl.MEM_SIZE), 1024);
+			const handle = first._;
+			cl.releasePooledBuffer(first);
+			assert.strictEqual(cl.getBufferPoolStats().cachedBytes, 1024);
+			
+			const hits = cl.getBufferPoolStats().hits;
+			const second = cl.createPooledBuffer(context, cl.MEM_READ_WRITE, 600);
+			assert.strictEqual(second._, handle);
+			assert.strictEqual(cl.getBufferPoolStats().hits, hits + 1);
+			
+			cl.releaseMemObject(second);
+		});
+		
+		it('keeps the cached bytes under the limit', () => {
+			cl.trimBufferPool();
+			cl.setBufferPoolLimit(1024);
+			try {
+				const buffers = [1, 2, 3].map(() => cl.createPooledBuffer(context, 0, 1024));
+				buffers.forEach((buffer) => cl.releasePooledBuffer(buffer));
+				assert.strictEqual(cl.getBufferPoolStats().cachedBuffers, 1);
+			} finally {
+				cl.setBufferPoolLimit(256 * 1024 * 1024);
+				cl.trimBufferPool();
+			}
+		});
+	});
+	
+	describe('Arena', () => {
+		it('sub-allocates aligned regions', () => {
+			const arena = new cl.Arena(context, 1 << 20);
+			const { alignment } = arena;
+			assert.ok(alignment > 0);
+			
+			const first = arena.alloc(100);
+			const second = arena.alloc(100);
+			assert.strictEqual(cl.getMemObjectInfo(first, cl.MEM_OFFSET), 0);
+			assert.strictEqual(cl.getMemObjectInfo(second, cl.MEM_OFFSET), alignment * Math.ceil(100 / alignment));
+			assert.strictEqual(cl.getMemObjectInfo(second, cl.MEM_SIZE), 100);
+			
+			const stats = arena.getStats();
+			assert.strictEqual(stats.allocations, 2);
+			assert.strictEqual(stats.highWater, stats.used);
+			
+			cl.releaseMemObject(first);
+			cl.releaseMemObject(second);
+		});
+		
+		it('reuses and merges the released regions', () => {
+			const arena = new cl.Arena(context, 1 << 20);
+			const first = arena.alloc(100);
+			const second = arena.alloc(100);
+			const third = arena.alloc(100);
+			const offset = cl.getMemObjectInfo(second, cl.MEM_OFFSET);
+			
+			cl.releaseMemObject(second);
+			assert.strictEqual(arena.getStats().freeRegions, 2);
+			
+			const reused = arena.alloc(100);
+			assert.strictEqual(cl.getMemObjectInfo(reused, cl.MEM_OFFSET), offset);
+			assert.strictEqual(arena.getStats().freeRegions, 1);
+			
+			cl.releaseMemObject(first);
+			cl.releaseMemObject(reused);
+			const stats = arena.getStats();
+			assert.strictEqual(stats.freeRegions, 2);
+			assert.strictEqual(stats.largestFree, stats.size - 3 * offset);
+			
+			cl.releaseMemObject(third);
+			const statsEmpty = arena.getStats();
+			assert.strictEqual(statsEmpty.freeRegions, 1);
+			assert.strictEqual(statsEmpty.free, statsEmpty.size);
+			assert.strictEqual(statsEmpty.fragmentation, 0);
+		});
+		
+		it('borrows the underlying buffer', () => {
+			const arena = new cl.Arena(context, 1 << 16);
+			const { buffer } = arena;
+			assert.ok(buffer);
+			const count = cl.getMemObjectInfo(buffer, cl.MEM_REFERENCE_COUNT);
+			assert.ok(arena.buffer);
+			assert.strictEqual(cl.getMemObjectInfo(buffer, cl.MEM_REFERENCE_COUNT), count);
+		});
+		
+		it('throws when out of space', () => {
+			const arena = new cl.Arena(context, 1 << 16);
+			assert.throws(() => arena.alloc(1 << 17), cl.MEM_OBJECT_ALLOCATION_FAILURE);
+		});
+	});
+	
+	describe('#setObjectTracking', () => {
+		it('reports the live objects', () => {
+			cl.setObjectTracking(true, true);
+			try {
+				const statsBefore = cl.getObjectStats().cl_mem;
+				const tracked = cl.createBuffer(context, 0, 64);
+				
+				const stats = cl.getObjectStats().cl_mem;
+				assert.strictEqual(stats?.count, (statsBefore?.count ?? 0) + 1);
+				assert.strictEqual(stats?.bytes, (statsBefore?.bytes ?? 0) + 64);
+				
+				const [oldest] = cl.getLiveObjects(1);
+				assert.strictEqual(oldest?.type, 'cl_mem');
+				assert.strictEqual(oldest?.handle, tracked._);
+				assert.ok(oldest?.site?.includes('memobj.test.ts'));
+				
+				cl.releaseMemObject(tracked);
+				assert.deepStrictEqual(cl.getObjectStats().cl_mem, statsBefore);
+			} finally {
+				cl.setObjectTracking(false);
+			}
+		});
+	});
+	
+	describe('SVM', () => {
+		const getSvmCaps = (): number => {
+			try {
+				return Number(cl.getDeviceInfo(device, cl.DEVICE_SVM_CAPABILITIES));
+			} catch {
+				return 0;
+			}
+		};
+		const isFineGrain = (getSvmCaps() & cl.DEVICE_SVM_FINE_GRAIN_BUFFER) !== 0;
+		
+		it('allocates fine-grained SVM', { skip: !isFineGrain }, () => {
+			const svm = cl.svmAlloc(context, cl.MEM_READ_WRITE | cl.MEM_SVM_FINE_GRAIN_BUFFER, 64);
+			assert.strictEqual(svm.byteLength, 64);
+			assert.strictEqual(cl.getLiveObjectCounts().svm_pointer, 1);
+			
+			new Uint8Array(svm).fill(9);
+			cl.svmFree(svm);
+			assert.strictEqual(svm.byteLength, 0);
+			assert.strictEqual(cl.getLiveObjectCounts().svm_pointer, 0);
+		});
+		
+		it('keeps the SVM memory set on a kernel', { skip: !isFineGrain || !globalThis.gc }, () => {
+			const program = cl.createProgramWithSource(context, 'kernel void k(global uchar *a) { a[0] = 1; }');
+			cl.buildProgram(program);
+			const kernel = cl.createKernel(program, 'k');
+			const setArg = () => {
+				const flags = cl.MEM_READ_WRITE | cl.MEM_SVM_FINE_GRAIN_BUFFER;
+				cl.setKernelArgSVMPointer(kernel, 0, cl.svmAlloc(context, flags, 64));
+			};
+			const countBefore = cl.getLiveObjectCounts().svm_pointer ?? 0;
+			setArg();
+			globalThis.gc?.();
+			assert.strictEqual(cl.getLiveObjectCounts().svm_pointer, countBefore + 1);
+			
+			cl.releaseKernel(kernel);
+			cl.releaseProgram(program);
+		});
+		
+		it('throws on a non-SVM ArrayBuffer', () => {
+			assert.throws(() => cl.svmFree(new ArrayBuffer(8)));
+		});
+	});
 });
@@ -0,0 +1,80 @@
+import { strict as assert } from 'node:assert';
+import { describe, it, after } from 'node:test';
+import * as cl from './index.ts';
+import * as U from './utils.ts';
+
+
+describe('MemoryBudget', () => {
+	const { context, device } = cl.quickStart();
+	const cq = U.newQueue(context, device);
+	
+	after(() => {
+		cl.releaseCommandQueue(cq);
+	});
+	
+	describe('#createMemoryBudget', () => {
+		it('seeds the budget from the device memory size', () => {
+			const budget = cl.createMemoryBudget(context, device, { fraction: 0.5 });
+			const total = Number(cl.getDeviceInfo(device, cl.DEVICE_GLOBAL_MEM_SIZE));
+			assert.strictEqual(budget.budget, Math.floor(total * 0.5));
+		});
+		
+		it('spills the least recently used buffer', () => {
+			const budget = cl.createMemoryBudget(context, device, { budget: 2048 });
+			const a = budget.createBuffer(1024);
+			const b = budget.createBuffer(1024);
+			const leaseA = a.use(cq);
+			cl.enqueueWriteBuffer(cq, leaseA.mems[0], true, 0, 1024, Buffer.alloc(1024, 7));
+			leaseA.release();
+			b.use(cq).release();
+			
+			const c = budget.createBuffer(1024);
+			assert.ok(!a.isResident);
+			assert.ok(b.isResident && c.isResident);
+			
+			const out = Buffer.alloc(1024);
+			const leaseRestored = a.use(cq);
+			cl.enqueueReadBuffer(cq, leaseRestored.mems[0], true, 0, 1024, out);
+			leaseRestored[Symbol.dispose]();
+			assert.strictEqual(out[1023], 7);
+			
+			const stats = budget.getStats();
+			assert.strictEqual(stats.residentBytes, 2048);
+			assert.strictEqual(stats.restores, 1);
+			assert.strictEqual(stats.bytesToHost, 2048);
+			assert.strictEqual(stats.bytesToDevice, 1024);
+			budget.dispose();
+		});
+		
+		it('keeps the buffers of useAll() resident together', () => {
+			const budget = cl.createMemoryBudget(context, device, { budget: 2048 });
+			const a = budget.createBuffer(1024);
+			const b = budget.createBuffer(1024);
+			const c = budget.createBuffer(1024);
+			const lease = budget.useAll(cq, [a, c]);
+			assert.strictEqual(lease.mems.length, 2);
+			assert.ok(a.isResident && c.isResident);
+			assert.ok(!b.isResident);
+			lease.release();
+			budget.dispose();
+		});
+		
+		it('never spills the leased buffers', () => {
+			const budget = cl.createMemoryBudget(context, device, { budget: 2048 });
+			const a = budget.createBuffer(1024);
+			const b = budget.createBuffer(1024);
+			const lease = budget.useAll(cq, [a, b]);
+			
+			const c = budget.createBuffer(1024);
+			budget.trim(0);
+			assert.ok(a.isResident && b.isResident);
+			assert.ok(!c.isResident);
+			assert.strictEqual(budget.getStats().residentBytes, 2048);
+			
+			lease.release();
+			budget.trim(0);
+			assert.ok(!a.isResident && !b.isResident);
+			budget.dispose();
+		});
+	});
+});
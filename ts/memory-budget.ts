@@ -0,0 +1,301 @@
+import { native } from './native.ts';
+import type { TClContext, TClDevice, TClMem, TClQueue } from './native.ts';
+
+const {
+	createBuffer,
+	releaseMemObject,
+	enqueueReadBuffer,
+	enqueueWriteBuffer,
+	getDeviceInfo,
+	DEVICE_GLOBAL_MEM_SIZE,
+	MEM_READ_WRITE,
+} = native;
+
+export type TMemoryBudgetOptions = Readonly<{
+	/** The budget in bytes. By default, a `fraction` of `DEVICE_GLOBAL_MEM_SIZE`. */
+	budget?: number;
+	/** 0.8 by default. */
+	fraction?: number;
+}>;
+
+export type TMemoryBudgetStats = Readonly<{
+	budget: number;
+	residentBytes: number;
+	spilledBytes: number;
+	buffers: number;
+	evictions: number;
+	restores: number;
+	/** Bytes read back to host on eviction. */
+	bytesToHost: number;
+	/** Bytes uploaded again on restore. */
+	bytesToDevice: number;
+}>;
+
+/**
+ * The device buffers of `use()` or `useAll()`. They are not spilled
+ * until the lease is released, so they stay valid for the commands using them.
+*/
+export type TMemoryLease = {
+	/** The device buffers, in the order of the leased buffers. */
+	readonly mems: readonly TClMem[];
+	/** Let the buffers be spilled again. Also available as `Symbol.dispose`. */
+	release: () => void;
+	[Symbol.dispose]: () => void;
+};
+
+/**
+ * A buffer that may be moved out of the device memory, when the budget is short.
+*/
+export type TManagedBuffer = {
+	readonly size: number;
+	readonly isResident: boolean;
+	/** Lease the device buffer, uploading the spilled data first if necessary. */
+	use: (queue: TClQueue) => TMemoryLease;
+	release: () => void;
+};
+
+export type TMemoryBudget = {
+	readonly budget: number;
+	setBudget: (budget: number) => void;
+	createBuffer: (size: number, flags?: number) => TManagedBuffer;
+	/** Lease all the `buffers` at once, e.g. for the args of one kernel. */
+	useAll: (queue: TClQueue, buffers: readonly TManagedBuffer[]) => TMemoryLease;
+	/** Spill the least recently used buffers that are not leased, until `target` bytes are resident. */
+	trim: (target: number) => void;
+	getStats: () => TMemoryBudgetStats;
+	/** Release all of the buffers. */
+	dispose: () => void;
+};
+
+type TEntry = {
+	size: number;
+	flags: number;
+	mem: TClMem | null;
+	host: Uint8Array | null;
+	/** The queue of the last use, where the data is read back from. */
+	queue: TClQueue | null;
+	stamp: number;
+	/** The unreleased leases, a leased buffer is never spilled. */
+	leases: number;
+};
+
+// The messages of MEM_OBJECT_ALLOCATION_FAILURE and OUT_OF_RESOURCES
+const isOutOfMemory = (error: unknown): boolean => (
+	error instanceof Error &&
+	(error.message === 'Memory object allocation failure' || error.message === 'Out of resources')
+);
+
+/**
+ * Track the device memory used by managed buffers against a budget.
+ *
+ * Least recently used buffers are read back to host memory when a buffer has
+ * to be allocated or restored over the budget, and are uploaded again on `use()`.
+ * Leased buffers stay resident, even if that takes more than the budget.
+ */
+export const createMemoryBudget = (
+	context: TClContext,
+	device: TClDevice,
+	options: TMemoryBudgetOptions = {},
+): TMemoryBudget => {
+	const { fraction = 0.8 } = options;
+	let budget = options.budget ?? Math.floor(Number(getDeviceInfo(device, DEVICE_GLOBAL_MEM_SIZE)) * fraction);
+	
+	const entries = new Set<TEntry>();
+	let stamp = 0;
+	let residentBytes = 0;
+	let evictions = 0;
+	let restores = 0;
+	let bytesToHost = 0;
+	let bytesToDevice = 0;
+	
+	const spill = (entry: TEntry): void => {
+		const mem = entry.mem as TClMem;
+		// A buffer that was never used has no data to keep
+		if (entry.queue) {
+			entry.host = new Uint8Array(entry.size);
+			enqueueReadBuffer(entry.queue, mem, true, 0, entry.size, entry.host);
+			bytesToHost += entry.size;
+		}
+		releaseMemObject(mem);
+		entry.mem = null;
+		residentBytes -= entry.size;
+		evictions++;
+	};
+	
+	// Returns false if there is nothing left to spill
+	const spillOldest = (): boolean => {
+		let oldest: TEntry | null = null;
+		for (const entry of entries) {
+			if (entry.mem && !entry.leases && (!oldest || entry.stamp < oldest.stamp)) {
+				oldest = entry;
+			}
+		}
+		if (!oldest) {
+			return false;
+		}
+		spill(oldest);
+		return true;
+	};
+	
+	const allocate = (entry: TEntry): void => {
+		// Over the budget, but nothing else to spill: try anyway
+		while (residentBytes + entry.size > budget) {
+			if (!spillOldest()) {
+				break;
+			}
+		}
+		
+		// The driver may still run out of memory below the budget
+		for (;;) {
+			try {
+				entry.mem = createBuffer(context, entry.flags, entry.size, null);
+				break;
+			} catch (error) {
+				if (!isOutOfMemory(error) || !spillOldest()) {
+					throw error;
+				}
+			}
+		}
+		residentBytes += entry.size;
+	};
+	
+	// Call with the entry leased, so that it is not spilled by the others
+	const makeResident = (entry: TEntry, queue: TClQueue): TClMem => {
+		if (!entries.has(entry)) {
+			throw new Error('The managed buffer is released.');
+		}
+		
+		if (!entry.mem) {
+			allocate(entry);
+			if (entry.host) {
+				enqueueWriteBuffer(queue, entry.mem as TClMem, true, 0, entry.size, entry.host);
+				entry.host = null;
+				bytesToDevice += entry.size;
+				restores++;
+			}
+		}
+		
+		entry.queue = queue;
+		entry.stamp = ++stamp;
+		return entry.mem as TClMem;
+	};
+	
+	const lease = (queue: TClQueue, leased: readonly TEntry[]): TMemoryLease => {
+		for (const entry of leased) {
+			entry.leases++;
+		}
+		
+		let isReleased = false;
+		const release = (): void => {
+			if (isReleased) {
+				return;
+			}
+			isReleased = true;
+			for (const entry of leased) {
+				entry.leases--;
+			}
+		};
+		
+		try {
+			const mems = leased.map((entry) => makeResident(entry, queue));
+			return { mems, release, [Symbol.dispose]: release };
+		} catch (error) {
+			release();
+			throw error;
+		}
+	};
+	
+	const releaseEntry = (entry: TEntry): void => {
+		if (!entries.delete(entry)) {
+			return;
+		}
+		if (entry.mem) {
+			releaseMemObject(entry.mem);
+			entry.mem = null;
+			residentBytes -= entry.size;
+		}
+		entry.host = null;
+	};
+	
+	const byHandle = new WeakMap<TManagedBuffer, TEntry>();
+	
+	return {
+		get budget() {
+			return budget;
+		},
+		
+		setBudget: (value: number): void => {
+			budget = value;
+		},
+		
+		createBuffer: (size: number, flags = MEM_READ_WRITE): TManagedBuffer => {
+			const entry: TEntry = {
+				size,
+				flags,
+				mem: null,
+				host: null,
+				queue: null,
+				stamp: ++stamp,
+				leases: 0,
+			};
+			
+			const handle: TManagedBuffer = {
+				size,
+				get isResident() {
+					return entry.mem !== null;
+				},
+				use: (queue: TClQueue): TMemoryLease => lease(queue, [entry]),
+				release: (): void => releaseEntry(entry),
+			};
+			
+			allocate(entry);
+			entries.add(entry);
+			byHandle.set(handle, entry);
+			return handle;
+		},
+		
+		useAll: (queue: TClQueue, buffers: readonly TManagedBuffer[]): TMemoryLease => {
+			const leased = buffers.map((buffer) => {
+				const entry = byHandle.get(buffer);
+				if (!entry) {
+					throw new Error('The managed buffer belongs to another budget.');
+				}
+				return entry;
+			});
+			return lease(queue, leased);
+		},
+		
+		trim: (target: number): void => {
+			while (residentBytes > target) {
+				if (!spillOldest()) {
+					break;
+				}
+			}
+		},
+		
+		getStats: (): TMemoryBudgetStats => {
+			let spilledBytes = 0;
+			for (const entry of entries) {
+				if (!entry.mem) {
+					spilledBytes += entry.size;
+				}
+			}
+			return {
+				budget,
+				residentBytes,
+				spilledBytes,
+				buffers: entries.size,
+				evictions,
+				restores,
+				bytesToHost,
+				bytesToDevice,
+			};
+		},
+		
+		dispose: (): void => {
+			for (const entry of [...entries]) {
+				releaseEntry(entry);
+			}
+		},
+	};
+};
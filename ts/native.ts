@@ -14,6 +14,12 @@ export type TClObject = {
      * Although unlikely necessary, but still a possible use case.
     */
     _: number;
+    /**
+     * Release the references that this object holds, right now.
+     * The object can't be used afterwards. Also available as `Symbol.dispose`.
+    */
+    dispose: () => void;
+    [Symbol.dispose]: () => void;
 };
 export type TClPlatform = TClObject & {
     __brand: "cl_platform_id";
@@ -43,6 +49,21 @@ export type TClEvent = TClObject & {
     __brand: "cl_event";
 };
 export type TClEventOrVoid = TClEvent | undefined;
+/**
+ * Numeric event handle, returned when `hasEvent` is `cl.EVENT_HANDLE`.
+ *
+ * The handle owns the event until it is passed in a wait list, then the event
+ * is released right after that command is enqueued. Each handle is valid once.
+ * Unused handles are freed with `releaseEventHandle()`.
+*/
+export type TClEventHandle = number & {
+    __brand: "cl_event_handle";
+};
+export type TClWaitList = readonly (TClEvent | TClEventHandle)[];
+export type TClEventFlag = boolean | 2;
+export type TClEventResult<H extends TClEventFlag> = H extends 2
+    ? TClEventHandle
+    : H extends true ? TClEvent : TClEventOrVoid;
 export type TClHostData = ArrayBuffer | ArrayBufferView | Buffer;
 export type TClImageFormat = {
     channel_order?: number;
@@ -63,6 +84,17 @@ export type TClSubBufferInfo = {
     size: number;
 };
 export type TBuildProgramCb = (program: TClProgram, userData: unknown) => void;
+export type TClBuildLog = Readonly<{
+    device: TClDevice;
+    log: string;
+}>;
+/**
+ * The rejection of `buildProgramAsync()`, with the build log of each device.
+*/
+export type TClBuildError = Error & Readonly<{
+    code: number;
+    logs: TClBuildLog[];
+}>;
 export type TWrapper = TClObject & {
     toString: () => string;
     valueOf: () => number;
@@ -71,22 +103,207 @@ export type TWrapperConstructor = {
     readonly prototype: TWrapper;
 };
 
+/**
+ * A recorded sequence of buffer transfers and kernel launches.
+ *
+ * Each recording method returns the index of the new command, pass such indices
+ * as `deps` of the later commands. Kernel args are converted at record time.
+ * The recorded host arrays, buffers and kernels are referenced until `clear()`.
+*/
+export type TCommandList = {
+    write: (mem: TClMem, offset: number, size: number, host: TClHostData, deps?: number[] | null) => number;
+    read: (mem: TClMem, offset: number, size: number, host: TClHostData, deps?: number[] | null) => number;
+    copy: (src: TClMem, dest: TClMem, srcOffset: number, destOffset: number, size: number, deps?: number[] | null) => number;
+    ndrange: (kernel: TClKernel, args: readonly unknown[] | null, workGlobal: number | number[], workLocal?: number | number[] | null, deps?: number[] | null) => number;
+    barrier: (deps?: number[] | null) => number;
+    /**
+     * Enqueue all of the recorded commands. The `waitList` gates the commands
+     * without deps, and the returned event completes after the whole list.
+     * The objects and host arrays are referenced until the run is complete,
+     * even if the list is cleared. If a command fails to enqueue, the commands
+     * before it stay enqueued.
+    */
+    run: <H extends TClEventFlag = false>(queue: TClQueue, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+    clear: () => void;
+    readonly length: number;
+};
+export type TCommandListConstructor = {
+    new (): TCommandList;
+    readonly prototype: TCommandList;
+};
+
+export type TArenaStats = Readonly<{
+    size: number;
+    used: number;
+    free: number;
+    /** The largest `used` so far. */
+    highWater: number;
+    allocations: number;
+    freeRegions: number;
+    largestFree: number;
+    /** 0 when the free memory is contiguous, close to 1 when it is scattered. */
+    fragmentation: number;
+}>;
+/**
+ * Hands out regions of one large buffer as sub-buffers.
+ *
+ * The regions are aligned to `DEVICE_MEM_BASE_ADDR_ALIGN`. A region is reused
+ * once its sub-buffer is released (and no longer used by the device).
+*/
+export type TArena = {
+    alloc: (size: number, flags?: number) => TClMem;
+    getStats: () => TArenaStats;
+    /** The underlying buffer, borrowed: it is owned by the arena, don't release it. */
+    readonly buffer: TClMem | null;
+    readonly alignment: number;
+};
+export type TArenaConstructor = {
+    new (context: TClContext, size: number, flags?: number): TArena;
+    readonly prototype: TArena;
+};
+/**
+ * A mapped region of a buffer or image, mapped when constructed.
+ *
+ * `unmap()` detaches `buffer`, so the memory can't be touched afterwards.
+ * A region that is still mapped when collected is unmapped asynchronously.
+*/
+export type TMapping = {
+    unmap: (waitList?: TClWaitList | null) => void;
+    /** The mapped memory, `null` after `unmap()`. */
+    readonly buffer: ArrayBuffer | null;
+    /** Only for images. */
+    readonly rowPitch: number;
+    /** Only for 3D images and image arrays. */
+    readonly slicePitch: number;
+    readonly isMapped: boolean;
+    [Symbol.dispose]: () => void;
+};
+export type TMappingConstructor = {
+    new (queue: TClQueue, buffer: TClMem, flags: number, offset: number, size: number): TMapping;
+    new (queue: TClQueue, image: TClMem, flags: number, origin: number[], region: number[]): TMapping;
+    readonly prototype: TMapping;
+};
+export type TBufferPoolStats = Readonly<{
+    cachedBytes: number;
+    cachedBuffers: number;
+    limit: number;
+    hits: number;
+    misses: number;
+}>;
+export type TClObjectStats = Readonly<{
+    count: number;
+    /** Total size of the `cl_mem` objects, 0 for other types. */
+    bytes: number;
+}>;
+/**
+ * A live CL object, as tracked after `setObjectTracking(true)`.
+*/
+export type TClLiveObject = Readonly<{
+    type: string;
+    handle: number;
+    /** Creation order, the lower the older. */
+    serial: number;
+    /** References taken through the JS API and not released yet. */
+    refs: number;
+    bytes: number;
+    ageMs: number;
+    /** JS stack of the creating call, if captured. */
+    site: string | null;
+}>;
+
 type TNative = Readonly<{
 	Wrapper: TWrapperConstructor;
+	CommandList: TCommandListConstructor;
+	Arena: TArenaConstructor;
+	Mapping: TMappingConstructor;
+	EVENT_HANDLE: 2;
+	setAutoRelease: (isEnabled: boolean) => void;
+	getLiveObjectCounts: () => Readonly<Record<string, number>>;
+	setObjectTracking: (isEnabled: boolean, isCapturingStacks?: boolean) => void;
+	getObjectStats: () => Readonly<Record<string, TClObjectStats>>;
+	getLiveObjects: (limit?: number) => TClLiveObject[];
 	createProgram: (context: TClContext, source: string) => TClProgram;
 	createKernel: (program: TClProgram, name: string) => TClKernel;
+	/**
+	 * A kernel of the same function, with its own arg state. The arg values are
+	 * copied by OpenCL 2.1+, otherwise the clone starts with no args set.
+	*/
+	cloneKernel: (kernel: TClKernel) => TClKernel;
 	createKernelsInProgram: (program: TClProgram) => TClKernel[];
 	retainKernel: (kernel: TClKernel) => void;
 	releaseKernel: (kernel: TClKernel) => void;
 	setKernelArg: (kernel: TClKernel, argIdx: number, argType: string | null, value: unknown) => number;
+	setKernelArgs: (kernel: TClKernel, values: readonly unknown[], argTypes?: readonly (string | null)[] | null) => number;
+	/**
+	 * Set the arg type names in advance, so that `setKernelArg()` without a type
+	 * doesn't need the kernel arg info. Returns how many types are known.
+	*/
+	setKernelArgTypes: (kernel: TClKernel, argTypes: readonly (string | null)[]) => number;
 	getKernelInfo: (kernel: TClKernel, paramName: number) => (string | number | TClContext | TClProgram);
 	getKernelArgInfo: (kernel: TClKernel, argIdx: number, paramName: number) => (string | number);
 	getKernelWorkGroupInfo: (kernel: TClKernel, device: TClDevice, paramName: number) => (number | number[]);
 	createBuffer: (context: TClContext, flags: number, size: number, buffer?: TClHostData | null) => TClMem;
+	/**
+	 * Create a buffer from a file region, without reading it into JS memory.
+	 *
+	 * The file is memory-mapped (copy-on-write) and used as `MEM_USE_HOST_PTR`,
+	 * until the buffer is destroyed. With `MEM_COPY_HOST_PTR` in `flags`, the data
+	 * is copied once and the file is unmapped right away.
+	 * The `length` defaults to the rest of the file.
+	*/
+	createBufferFromFile: (context: TClContext, path: string, flags?: number, range?: { offset?: number; length?: number }) => TClMem;
 	createSubBuffer: (mem: TClMem, flags: number, origin: number, size: number) => TClMem;
 	createImage: (context: TClContext, flags: number, format: TClImageFormat, desc: TClImageDesc, host?: TClHostData | null) => TClMem;
 	retainMemObject: (mem: TClMem) => void;
 	releaseMemObject: (mem: TClMem) => void;
+	/**
+	 * Create a buffer of the next power of 2 size (256 bytes minimum), reusing a
+	 * released one of the same context, flags and size when available.
+	 * The contents of a reused buffer are undefined. Host pointer flags are not allowed.
+	*/
+	createPooledBuffer: (context: TClContext, flags: number, size: number) => TClMem;
+	/** Give a pooled buffer back, the `mem` object can't be used afterwards. */
+	releasePooledBuffer: (mem: TClMem) => void;
+	/** Free the cached buffers down to `targetBytes`. Returns the freed bytes. */
+	trimBufferPool: (targetBytes?: number) => number;
+	/** The cap on cached bytes, 256 MiB by default. */
+	setBufferPoolLimit: (limitBytes: number) => void;
+	getBufferPoolStats: () => TBufferPoolStats;
+	/**
+	 * Take a pinned host buffer of at least `size` bytes, for fast transfers.
+	 *
+	 * The memory comes from a pool of mapped `MEM_ALLOC_HOST_PTR` buffers, and
+	 * goes back there on `releaseStagingBuffer()`, which also detaches the ArrayBuffer.
+	 * A buffer that is dropped without release gives its slot back when collected.
+	*/
+	acquireStagingBuffer: (queue: TClQueue, size: number) => ArrayBuffer;
+	/**
+	 * Give a staging buffer back to the pool. Pass the events of the non-blocking
+	 * transfers that still use it: the memory is only reused after they complete.
+	*/
+	releaseStagingBuffer: (buffer: ArrayBuffer, waitList?: TClWaitList | null) => void;
+	/** Free the pooled staging buffers that are not in use. Returns the freed bytes. */
+	trimStagingBuffers: () => number;
+	/**
+	 * Allocate Shared Virtual Memory (OpenCL 2.0), as an ArrayBuffer.
+	 *
+	 * The memory is freed by `svmFree()`, or when the ArrayBuffer is collected.
+	 * A kernel that it is set on (as an arg or exec info) keeps it from collection,
+	 * and so does each launch of such a kernel, until the launch is complete.
+	 * `svmFree()` doesn't wait for the commands using the memory.
+	 * Coarse-grained SVM has to be mapped with `enqueueSVMMap()` for host access.
+	 * Throws `INVALID_OPERATION` if the OpenCL library has no SVM support.
+	*/
+	svmAlloc: (context: TClContext, flags: number, size: number, alignment?: number) => ArrayBuffer;
+	/** Free the SVM memory right away, and detach the ArrayBuffer. */
+	svmFree: (buffer: ArrayBuffer) => void;
+	/** A view sets a pointer inside of the SVM allocation. */
+	setKernelArgSVMPointer: (kernel: TClKernel, index: number, value: TClHostData) => void;
+	/**
+	 * With `KERNEL_EXEC_INFO_SVM_PTRS`, `value` is an Array of the SVM memory
+	 * used indirectly by the kernel. `KERNEL_EXEC_INFO_SVM_FINE_GRAIN_SYSTEM` takes a Boolean.
+	*/
+	setKernelExecInfo: (kernel: TClKernel, paramName: number, value: TClHostData[] | boolean) => void;
 	getSupportedImageFormats: (context: TClContext, flags: number, imageType: number) => TClImageFormat[];
 	getMemObjectInfo: (mem: TClMem, paramName: number) => (number | TClMem | TClContext | ArrayBuffer | null);
 	getImageInfo: (mem: TClMem, paramName: number) => (number | TClMem);
@@ -97,14 +314,24 @@ type TNative = Readonly<{
 	getPlatformInfo: (platform: TClPlatform, paramName: number) => string;
 	createProgramWithSource: (context: TClContext, source: string) => TClProgram;
 	createProgramWithBinary: (context: TClContext, devices: TClDevice[], binaries: TClHostData[]) => TClProgram;
+	/**
+	 * Create a program from SPIR-V, on OpenCL 2.1+ or with `cl_khr_il_program`.
+	 * See `DEVICE_IL_VERSION` for the supported versions.
+	*/
+	createProgramWithIL: (context: TClContext, il: TClHostData) => TClProgram;
 	createProgramWithBuiltInKernels: (context: TClContext, devices: TClDevice[], names: string[]) => TClProgram;
 	retainProgram: (program: TClProgram) => void;
 	releaseProgram: (program: TClProgram) => void;
 	buildProgram: (program: TClProgram, devices?: TClDevice[] | null, options?: string | null, cb?: TBuildProgramCb | null, userData?: unknown) => void;
+	/**
+	 * Build on a native worker thread, several programs build in parallel
+	 * (up to `UV_THREADPOOL_SIZE`). Rejects with a `TClBuildError`.
+	*/
+	buildProgramAsync: (program: TClProgram, devices?: TClDevice[] | null, options?: string | null) => Promise<void>;
 	compileProgram: (program: TClProgram, devices?: TClDevice[] | null, options?: string | null, headers?: TClProgram[] | null, names?: string[] | null, cb?: TBuildProgramCb | null, userData?: unknown) => void;
 	linkProgram: (context: TClContext, devices?: TClDevice[] | null, options?: string | null, programs?: TClProgram[], cb?: TBuildProgramCb | null, userData?: unknown) => TClProgram;
 	unloadPlatformCompiler: (platform: TClPlatform) => void;
-	getProgramInfo: (program: TClProgram, paramName: number) => (number | TClContext | TClDevice[] | number[] | ArrayBuffer[] | string);
+	getProgramInfo: (program: TClProgram, paramName: number) => (number | TClContext | TClDevice[] | number[] | ArrayBuffer[] | ArrayBuffer | string | null);
 	getProgramBuildInfo: (program: TClProgram, device: TClDevice, paramName: number) => (number | string);
 	createSampler: (context: TClContext, normalized: boolean | number, addressingMode: number, filterMode: number) => TClSampler;
 	retainSampler: (sampler: TClSampler) => void;
@@ -116,17 +343,22 @@ type TNative = Readonly<{
 	getCommandQueueInfo: (queue: TClQueue, paramName: number) => (TClContext | TClDevice | number);
 	flush: (queue: TClQueue) => void;
 	finish: (queue: TClQueue) => void;
-	enqueueReadBuffer: (queue: TClQueue, buffer: TClMem, blockingRead: boolean, offset: number, size: number, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueReadBufferRect: (queue: TClQueue, buffer: TClMem, blockingRead: boolean, bufferOffset: number[], hostOffset: number[], region: number[], bufferRowPitch: number, bufferSlicePitch: number, hostRowPitch: number, hostSlicePitch: number, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueWriteBuffer: (queue: TClQueue, buffer: TClMem, blockingWrite: boolean, offset: number, size: number, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueWriteBufferRect: (queue: TClQueue, buffer: TClMem, blockingWrite: boolean, bufferOffsets: number[], hostOffsets: number[], regions: number[], bufferRowPitch: number, bufferSlicePitch: number, hostRowPitch: number, hostSlicePitch: number, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueCopyBuffer: (queue: TClQueue, src: TClMem, dest: TClMem, srcOffset: number, destOfset: number, size: number, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueCopyBufferRect: (queue: TClQueue, src: TClMem, dest: TClMem, srcOrigins: number[], destOrigins: number[], regions: number[], srcRowPitch: number, srcSlicePitch: number, destRowPitch: number, destSlicePitch: number, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueReadImage: (queue: TClQueue, image: TClMem, blockingRead: boolean, srcOrigins: number[], regions: number[], rowPitch: number, slicePitch: number, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueWriteImage: (queue: TClQueue, image: TClMem, blockingWrite: boolean, srcOrigins: number[], regions: number[], rowPitch: number, slicePitch: number, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueCopyImage: (queue: TClQueue, src: TClMem, dest: TClMem, srcOrigins: number[], destOrigins: number[], regions: number[], waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueCopyImageToBuffer: (queue: TClQueue, src: TClMem, dest: TClMem, srcOrigins: number[], regions: number[], destOffset: number, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueCopyBufferToImage: (queue: TClQueue, src: TClMem, dest: TClMem, srcOffset: number, destOrigins: number[], regions: number[], waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
+	finishAsync: (queue: TClQueue) => Promise<void>;
+	enqueueReadBuffer: <H extends TClEventFlag = false>(queue: TClQueue, buffer: TClMem, blockingRead: boolean, offset: number, size: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueReadBufferAsync: <T extends TClHostData>(queue: TClQueue, buffer: TClMem, offset: number, size: number, host: T, waitList?: TClWaitList | null) => Promise<T>;
+	enqueueReadBufferRect: <H extends TClEventFlag = false>(queue: TClQueue, buffer: TClMem, blockingRead: boolean, bufferOffset: number[], hostOffset: number[], region: number[], bufferRowPitch: number, bufferSlicePitch: number, hostRowPitch: number, hostSlicePitch: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueWriteBuffer: <H extends TClEventFlag = false>(queue: TClQueue, buffer: TClMem, blockingWrite: boolean, offset: number, size: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueWriteBufferAsync: (queue: TClQueue, buffer: TClMem, offset: number, size: number, host: TClHostData, waitList?: TClWaitList | null) => Promise<void>;
+	enqueueWriteBufferRect: <H extends TClEventFlag = false>(queue: TClQueue, buffer: TClMem, blockingWrite: boolean, bufferOffsets: number[], hostOffsets: number[], regions: number[], bufferRowPitch: number, bufferSlicePitch: number, hostRowPitch: number, hostSlicePitch: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueCopyBuffer: <H extends TClEventFlag = false>(queue: TClQueue, src: TClMem, dest: TClMem, srcOffset: number, destOfset: number, size: number, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueCopyBufferRect: <H extends TClEventFlag = false>(queue: TClQueue, src: TClMem, dest: TClMem, srcOrigins: number[], destOrigins: number[], regions: number[], srcRowPitch: number, srcSlicePitch: number, destRowPitch: number, destSlicePitch: number, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueReadImage: <H extends TClEventFlag = false>(queue: TClQueue, image: TClMem, blockingRead: boolean, srcOrigins: number[], regions: number[], rowPitch: number, slicePitch: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueReadImageAsync: <T extends TClHostData>(queue: TClQueue, image: TClMem, srcOrigins: number[], regions: number[], rowPitch: number, slicePitch: number, host: T, waitList?: TClWaitList | null) => Promise<T>;
+	enqueueWriteImage: <H extends TClEventFlag = false>(queue: TClQueue, image: TClMem, blockingWrite: boolean, srcOrigins: number[], regions: number[], rowPitch: number, slicePitch: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueWriteImageAsync: (queue: TClQueue, image: TClMem, srcOrigins: number[], regions: number[], rowPitch: number, slicePitch: number, host: TClHostData, waitList?: TClWaitList | null) => Promise<void>;
+	enqueueCopyImage: <H extends TClEventFlag = false>(queue: TClQueue, src: TClMem, dest: TClMem, srcOrigins: number[], destOrigins: number[], regions: number[], waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueCopyImageToBuffer: <H extends TClEventFlag = false>(queue: TClQueue, src: TClMem, dest: TClMem, srcOrigins: number[], regions: number[], destOffset: number, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueCopyBufferToImage: <H extends TClEventFlag = false>(queue: TClQueue, src: TClMem, dest: TClMem, srcOffset: number, destOrigins: number[], regions: number[], waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
 	enqueueMapBuffer: (
 		queue: TClQueue,
 		mem: TClMem,
@@ -134,11 +366,21 @@ type TNative = Readonly<{
 		mapFlags: number,
 		offset: number,
 		size: number,
-		waitList?: TClEvent[] | null,
+		waitList?: TClWaitList | null,
 	) => Readonly<{
 		buffer: ArrayBuffer;
 		event: TClEvent | null;
 	}>;
+	enqueueMapBufferAsync: (
+		queue: TClQueue,
+		mem: TClMem,
+		mapFlags: number,
+		offset: number,
+		size: number,
+		waitList?: TClWaitList | null,
+	) => Promise<Readonly<{
+		buffer: ArrayBuffer;
+	}>>;
 	enqueueMapImage: (
 		queue: TClQueue,
 		mem: TClMem,
@@ -146,26 +388,50 @@ type TNative = Readonly<{
 		mapFlags: number,
 		origins: number[],
 		regions: number[],
-		waitList?: TClEvent[] | null,
+		waitList?: TClWaitList | null,
 	) => Readonly<{
 		buffer: ArrayBuffer;
 		event: TClEvent | null;
 		image_row_pitch: number;
 		image_slice_pitch: number;
 	}>;
-	enqueueUnmapMemObject: (queue: TClQueue, mem: TClMem, host: TClHostData, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueNDRangeKernel: (queue: TClQueue, kernel: TClKernel, workDim: number, workOffset?: number[] | null, workGlobal?: number[] | null, workLocal?: number[] | null, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueTask: (queue: TClQueue, kernel: TClKernel, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
+	enqueueMapImageAsync: (
+		queue: TClQueue,
+		mem: TClMem,
+		mapFlags: number,
+		origins: number[],
+		regions: number[],
+		waitList?: TClWaitList | null,
+	) => Promise<Readonly<{
+		buffer: ArrayBuffer;
+		image_row_pitch: number;
+		image_slice_pitch: number;
+	}>>;
+	enqueueUnmapMemObject: <H extends TClEventFlag = false>(queue: TClQueue, mem: TClMem, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueNDRangeKernel: <H extends TClEventFlag = false>(queue: TClQueue, kernel: TClKernel, workDim: number, workOffset?: number[] | null, workGlobal?: number[] | null, workLocal?: number[] | null, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	/**
+	 * Bind `args` (by the introspected arg types, see `setKernelArgTypes()`)
+	 * and enqueue the kernel. The work sizes are 1 to 3 non-negative integers.
+	*/
+	dispatch: <H extends TClEventFlag = false>(queue: TClQueue, kernel: TClKernel, args: readonly unknown[] | null, workGlobal: number | number[], workLocal?: number | number[] | null, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueTask: <H extends TClEventFlag = false>(queue: TClQueue, kernel: TClKernel, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
 	enqueueNativeKernel: () => TClEventOrVoid;
-	enqueueMarker: (queue: TClQueue) => TClEvent;
-	enqueueMarkerWithWaitList: (queue: TClQueue, waitList: TClEvent[]) => TClEvent;
-	enqueueBarrierWithWaitList: (queue: TClQueue, waitList: TClEvent[], hasEvent?: boolean) => TClEventOrVoid;
+	enqueueMarker: <H extends true | 2 = true>(queue: TClQueue, hasEvent?: H) => TClEventResult<H>;
+	enqueueMarkerWithWaitList: <H extends true | 2 = true>(queue: TClQueue, waitList: TClWaitList, hasEvent?: H) => TClEventResult<H>;
+	enqueueBarrierWithWaitList: <H extends TClEventFlag = false>(queue: TClQueue, waitList: TClWaitList, hasEvent?: H) => TClEventResult<H>;
 	enqueueBarrier: (queue: TClQueue) => TClEventOrVoid;
-	enqueueFillBuffer: (queue: TClQueue, buffer: TClMem, pattern: number | TClHostData, offset: number, size: number, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueFillImage: (queue: TClQueue, image: TClMem, host: TClHostData, srcOrigins: number[], regions: number[], waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueMigrateMemObjects: (queue: TClQueue, objectt: TClMem[], flags: number, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueAcquireGLObjects: (queue: TClQueue, mem: TClMem, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
-	enqueueReleaseGLObjects: (queue: TClQueue, mem: TClMem, waitList?: TClEvent[] | null, hasEvent?: boolean) => TClEventOrVoid;
+	enqueueFillBuffer: <H extends TClEventFlag = false>(queue: TClQueue, buffer: TClMem, pattern: number | TClHostData, offset: number, size: number, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueFillImage: <H extends TClEventFlag = false>(queue: TClQueue, image: TClMem, host: TClHostData, srcOrigins: number[], regions: number[], waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueMigrateMemObjects: <H extends TClEventFlag = false>(queue: TClQueue, objectt: TClMem[], flags: number, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueAcquireGLObjects: <H extends TClEventFlag = false>(queue: TClQueue, mem: TClMem, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueReleaseGLObjects: <H extends TClEventFlag = false>(queue: TClQueue, mem: TClMem, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	/** Map the whole SVM `host` view. */
+	enqueueSVMMap: <H extends TClEventFlag = false>(queue: TClQueue, isBlocking: boolean, flags: number, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	enqueueSVMUnmap: <H extends TClEventFlag = false>(queue: TClQueue, host: TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	/** Either `dest` or `src` may be regular host memory. */
+	enqueueSVMMemcpy: <H extends TClEventFlag = false>(queue: TClQueue, isBlocking: boolean, dest: TClHostData, src: TClHostData, size: number, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
+	/** Fill the whole SVM `host` view with a 32-bit value, or a pattern. */
+	enqueueSVMMemFill: <H extends TClEventFlag = false>(queue: TClQueue, host: TClHostData, pattern: number | TClHostData, waitList?: TClWaitList | null, hasEvent?: H) => TClEventResult<H>;
 	createContext: (properties: (number | TClPlatform)[] | null, devices: TClDevice[]) => TClContext;
 	createContextFromType: (properties: (number | TClPlatform)[] | null, deviceType: number) => TClContext;
 	retainContext: (context: TClContext) => void;
@@ -176,7 +442,11 @@ type TNative = Readonly<{
 	createSubDevices: (device: TClDevice, properties: number[]) => TClDevice[];
 	retainDevice: (device: TClDevice) => void;
 	releaseDevice: (device: TClDevice) => void;
-	waitForEvents: (waitList: TClEvent[]) => void;
+	waitForEvents: (waitList: TClWaitList) => void;
+	waitForEventsAsync: (waitList: TClWaitList) => Promise<void>;
+	releaseEventHandle: (handle: TClEventHandle) => void;
+	eventFromHandle: (handle: TClEventHandle) => TClEvent;
+	getEventHandleCount: () => number;
 	getEventInfo: (event: TClEvent, paramName: number) => (TClQueue | TClContext | number);
 	createUserEvent: (context: TClContext) => TClEvent;
 	retainEvent: (event: TClEvent) => void;
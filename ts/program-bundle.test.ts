@@ -0,0 +1,113 @@
+import fs from 'node:fs';
+import { strict as assert } from 'node:assert';
+import { describe, it, after } from 'node:test';
+import { tmpdir } from 'node:os';
+import { join } from 'node:path';
+import * as cl from './index.ts';
+import * as U from './utils.ts';
+
+const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
+const squareCpyKern = fs.readFileSync(new URL('../examples/assets/kernels/square_cpy.cl', import.meta.url)).toString();
+
+
+describe('ProgramBundle', () => {
+	const { context, device } = cl.quickStart();
+	const queue = U.newQueue(context, device);
+	const dir = fs.mkdtempSync(join(tmpdir(), 'opencl-bundle-'));
+	
+	const programs = [squareKern, squareCpyKern].map((source) => {
+		const program = cl.createProgramWithSource(context, source);
+		cl.buildProgram(program, null, '-cl-kernel-arg-info');
+		return program;
+	});
+	
+	after(() => {
+		programs.forEach((program) => cl.releaseProgram(program));
+		cl.releaseCommandQueue(queue);
+		fs.rmSync(dir, { recursive: true, force: true });
+	});
+	
+	// Replaces the arg types of the named kernels in the bundle header
+	const retypeBundle = (data: Buffer, types: Readonly<Record<string, string[]>>): Buffer => {
+		const headerEnd = 12 + data.readUInt32LE(8);
+		const header = JSON.parse(data.toString('utf8', 12, headerEnd)) as {
+			programs: { kernels: { name: string; args: string[] | null }[] }[];
+		};
+		for (const { kernels } of header.programs) {
+			for (const kernel of kernels) {
+				kernel.args = types[kernel.name] ?? kernel.args;
+			}
+		}
+		
+		const json = Buffer.from(JSON.stringify(header));
+		const prefix = Buffer.from(data.subarray(0, 12));
+		prefix.writeUInt32LE(json.length, 8);
+		return Buffer.concat([prefix, json, data.subarray(headerEnd)]);
+	};
+	
+	const releaseBundled = (bundled: cl.TBundledProgram[]): void => {
+		for (const { program, kernels } of bundled) {
+			Object.values(kernels).forEach((kernel) => cl.releaseKernel(kernel));
+			cl.releaseProgram(program);
+		}
+	};
+	
+	describe('#writeProgramBundle', () => {
+		it('restores all programs and kernels from a file', () => {
+			const path = join(dir, 'programs.bin');
+			cl.writeProgramBundle(path, programs);
+			
+			const bundled = cl.readProgramBundle(context, path);
+			assert.strictEqual(bundled.length, 2);
+			assert.deepStrictEqual(Object.keys(bundled[0].kernels), ['square']);
+			assert.deepStrictEqual(Object.keys(bundled[1].kernels), ['square_cpy']);
+			
+			releaseBundled(bundled);
+		});
+	});
+	
+	describe('#unpackProgramBundle', () => {
+		it('restores kernels with their arg types', () => {
+			const bundled = cl.unpackProgramBundle(context, cl.packProgramBundle(programs), [device]);
+			const { square } = bundled[0].kernels;
+			
+			const input = new Float32Array([1, 2, 3, 4]);
+			const output = new Float32Array(4);
+			const inputMem = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, input);
+			const outputMem = cl.createBuffer(context, cl.MEM_WRITE_ONLY, 16, null);
+			
+			cl.dispatch(queue, square, [inputMem, outputMem, 4], 4);
+			cl.enqueueReadBuffer(queue, outputMem, true, 0, 16, output);
+			assert.deepStrictEqual(Array.from(output), [1, 4, 9, 16]);
+			
+			cl.releaseMemObject(inputMem);
+			cl.releaseMemObject(outputMem);
+			releaseBundled(bundled);
+		});
+		
+		it('prefers the arg types of the bundle over the arg info', () => {
+			// The driver's arg info says `uint`, so only the bundle types can reject a Number
+			const data = retypeBundle(cl.packProgramBundle(programs), {
+				square: ['float*', 'float*', 'float*'],
+			});
+			const bundled = cl.unpackProgramBundle(context, data, [device]);
+			const { square } = bundled[0].kernels;
+			
+			const mem = cl.createBuffer(context, cl.MEM_READ_WRITE, 16, null);
+			assert.throws(
+				() => cl.dispatch(queue, square, [mem, mem, 4], 4),
+				new Error('Array item #2 must be of type `Object`'),
+			);
+			
+			cl.releaseMemObject(mem);
+			releaseBundled(bundled);
+		});
+		
+		it('throws for other data', () => {
+			assert.throws(
+				() => cl.unpackProgramBundle(context, new Uint8Array(64)),
+				new Error('Not a program bundle, or a different version.'),
+			);
+		});
+	});
+});
@@ -0,0 +1,223 @@
+import { readFileSync } from 'node:fs';
+import { writeAtomic } from './binary-cache.ts';
+import { native } from './native.ts';
+import type { TClContext, TClDevice, TClKernel, TClProgram } from './native.ts';
+
+const {
+	createProgramWithBinary,
+	buildProgram,
+	releaseProgram,
+	createKernel,
+	releaseKernel,
+	setKernelArgTypes,
+	getProgramInfo,
+	getProgramBuildInfo,
+	getKernelInfo,
+	getKernelArgInfo,
+	getContextInfo,
+	getDeviceInfo,
+	CONTEXT_DEVICES,
+	DEVICE_NAME,
+	DRIVER_VERSION,
+	KERNEL_NUM_ARGS,
+	KERNEL_ARG_ADDRESS_QUALIFIER,
+	KERNEL_ARG_ADDRESS_LOCAL,
+	KERNEL_ARG_TYPE_NAME,
+	PROGRAM_BINARIES,
+	PROGRAM_BUILD_OPTIONS,
+	PROGRAM_DEVICES,
+	PROGRAM_KERNEL_NAMES,
+} = native;
+
+export type TBundledProgram = Readonly<{
+	program: TClProgram;
+	/** All kernels of the program, by name, with their arg types set. */
+	kernels: Readonly<Record<string, TClKernel>>;
+}>;
+
+type TBundleKernel = {
+	name: string;
+	/** Arg type names, `null` if the program was built without arg info. */
+	args: (string | null)[] | null;
+};
+
+type TBundleBinary = {
+	device: string;
+	offset: number;
+	size: number;
+};
+
+type TBundleProgram = {
+	options: string;
+	binaries: TBundleBinary[];
+	kernels: TBundleKernel[];
+};
+
+type TBundleHeader = {
+	programs: TBundleProgram[];
+};
+
+// "CLPB", the format version, the header size, then the JSON header and the binaries
+const MAGIC = 0x42504c43;
+const VERSION = 1;
+const PREFIX_SIZE = 12;
+
+// Binaries are only valid for the same device and driver
+const getDeviceKey = (device: TClDevice): string => [
+	String(getDeviceInfo(device, DEVICE_NAME)),
+	String(getDeviceInfo(device, DRIVER_VERSION)),
+].join('\n');
+
+const getArgTypes = (kernel: TClKernel): (string | null)[] | null => {
+	const count = getKernelInfo(kernel, KERNEL_NUM_ARGS) as number;
+	try {
+		return Array.from({ length: count }, (_v, i) => (
+			getKernelArgInfo(kernel, i, KERNEL_ARG_ADDRESS_QUALIFIER) === KERNEL_ARG_ADDRESS_LOCAL
+				? 'local'
+				: String(getKernelArgInfo(kernel, i, KERNEL_ARG_TYPE_NAME))
+		));
+	} catch {
+		// KERNEL_ARG_INFO_NOT_AVAILABLE, no `-cl-kernel-arg-info`
+		return null;
+	}
+};
+
+/**
+ * Serialize built programs: the binary for each device, the build options,
+ * and the kernel names with their arg types.
+ *
+ * Build with `-cl-kernel-arg-info` to have the arg types in the bundle.
+*/
+export const packProgramBundle = (programs: readonly TClProgram[]): Buffer => {
+	const header: TBundleHeader = { programs: [] };
+	const blobs: Uint8Array[] = [];
+	let offset = 0;
+	
+	for (const program of programs) {
+		const devices = getProgramInfo(program, PROGRAM_DEVICES) as TClDevice[];
+		const binaries = getProgramInfo(program, PROGRAM_BINARIES) as ArrayBuffer[];
+		
+		const bundleBinaries = devices.map((device, i): TBundleBinary => {
+			const blob = new Uint8Array(binaries[i]);
+			blobs.push(blob);
+			offset += blob.byteLength;
+			return { device: getDeviceKey(device), offset: offset - blob.byteLength, size: blob.byteLength };
+		});
+		
+		const names = String(getProgramInfo(program, PROGRAM_KERNEL_NAMES)).split(';').filter(Boolean);
+		const kernels = names.map((name): TBundleKernel => {
+			const kernel = createKernel(program, name);
+			try {
+				return { name, args: getArgTypes(kernel) };
+			} finally {
+				releaseKernel(kernel);
+			}
+		});
+		
+		header.programs.push({
+			options: String(getProgramBuildInfo(program, devices[0], PROGRAM_BUILD_OPTIONS)),
+			binaries: bundleBinaries,
+			kernels,
+		});
+	}
+	
+	const json = Buffer.from(JSON.stringify(header));
+	const prefix = Buffer.alloc(PREFIX_SIZE);
+	prefix.writeUInt32LE(MAGIC, 0);
+	prefix.writeUInt32LE(VERSION, 4);
+	prefix.writeUInt32LE(json.byteLength, 8);
+	
+	return Buffer.concat([prefix, json, ...blobs]);
+};
+
+const parseBundle = (data: Uint8Array): { header: TBundleHeader; blobs: Uint8Array } => {
+	const view = Buffer.from(data.buffer, data.byteOffset, data.byteLength);
+	if (
+		view.byteLength < PREFIX_SIZE ||
+		view.readUInt32LE(0) !== MAGIC ||
+		view.readUInt32LE(4) !== VERSION
+	) {
+		throw new Error('Not a program bundle, or a different version.');
+	}
+	
+	const blobStart = PREFIX_SIZE + view.readUInt32LE(8);
+	const header = JSON.parse(view.toString('utf8', PREFIX_SIZE, blobStart)) as TBundleHeader;
+	return { header, blobs: data.subarray(blobStart) };
+};
+
+const restoreProgram = (
+	context: TClContext,
+	devices: readonly TClDevice[],
+	deviceKeys: readonly string[],
+	entry: TBundleProgram,
+	blobs: Uint8Array,
+): TBundledProgram => {
+	const binaries = deviceKeys.map((key) => {
+		const binary = entry.binaries.find((b) => b.device === key && b.size > 0);
+		if (!binary) {
+			throw new Error(`The bundle has no binary for device "${key.split('\n')[0]}".`);
+		}
+		return blobs.subarray(binary.offset, binary.offset + binary.size);
+	});
+	
+	const program = createProgramWithBinary(context, [...devices], binaries);
+	const kernels: Record<string, TClKernel> = {};
+	try {
+		buildProgram(program, [...devices], entry.options);
+		for (const { name, args } of entry.kernels) {
+			const kernel = createKernel(program, name);
+			kernels[name] = kernel;
+			if (args) {
+				setKernelArgTypes(kernel, args);
+			}
+		}
+	} catch (error) {
+		Object.values(kernels).forEach((kernel) => releaseKernel(kernel));
+		releaseProgram(program);
+		throw error;
+	}
+	
+	return { program, kernels };
+};
+
+/**
+ * Restore the programs and their kernels from a bundle, for `devices`
+ * (all devices of `context` by default).
+ *
+ * Throws if a device or its driver has no binary in the bundle.
+ * The caller releases the programs and kernels.
+*/
+export const unpackProgramBundle = (
+	context: TClContext, data: Uint8Array, devices?: readonly TClDevice[] | null,
+): TBundledProgram[] => {
+	const { header, blobs } = parseBundle(data);
+	
+	const targets = devices ?? (getContextInfo(context, CONTEXT_DEVICES) as TClDevice[]);
+	const deviceKeys = targets.map(getDeviceKey);
+	
+	const result: TBundledProgram[] = [];
+	try {
+		for (const entry of header.programs) {
+			result.push(restoreProgram(context, targets, deviceKeys, entry, blobs));
+		}
+	} catch (error) {
+		for (const { program, kernels } of result) {
+			Object.values(kernels).forEach((kernel) => releaseKernel(kernel));
+			releaseProgram(program);
+		}
+		throw error;
+	}
+	
+	return result;
+};
+
+/** Write a bundle of `programs` to `path`, see `packProgramBundle()`. */
+export const writeProgramBundle = (path: string, programs: readonly TClProgram[]): void => {
+	// Readers never see a partial file
+	writeAtomic(path, packProgramBundle(programs));
+};
+
+/** Read a bundle from `path`, see `unpackProgramBundle()`. */
+export const readProgramBundle = (
+	context: TClContext, path: string, devices?: readonly TClDevice[] | null,
+): TBundledProgram[] => unpackProgramBundle(context, readFileSync(path), devices);
@@ -0,0 +1,40 @@
+import fs from 'node:fs';
+import { strict as assert } from 'node:assert';
+import { describe, it } from 'node:test';
+import * as cl from './index.ts';
+
+const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
+
+
+describe('ProgramCache', () => {
+	const { context } = cl.quickStart();
+	
+	describe('#createProgramCache', () => {
+		it('returns the same program for the same source and options', () => {
+			const cache = cl.createProgramCache();
+			const a = cache.acquire(context, squareKern);
+			const b = cache.acquire(context, squareKern);
+			const c = cache.acquire(context, squareKern, '-cl-fast-relaxed-math');
+			assert.strictEqual(a, b);
+			assert.notStrictEqual(a, c);
+			assert.deepStrictEqual(cache.getStats(), { programs: 2, hits: 1, misses: 2 });
+			
+			cache.release(a);
+			cache.release(b);
+			cache.release(c);
+			assert.strictEqual(cache.getStats().programs, 0);
+		});
+		
+		it('keeps the program until the last release', () => {
+			const cache = cl.createProgramCache();
+			const a = cache.acquire(context, squareKern);
+			cache.acquire(context, squareKern);
+			cache.release(a);
+			
+			const kernel = cl.createKernel(a, 'square');
+			cl.releaseKernel(kernel);
+			cache.release(a);
+			assert.throws(() => cache.release(a), new Error('The program is not from this cache.'));
+		});
+	});
+});
@@ -0,0 +1,95 @@
+import { createHash } from 'node:crypto';
+import { native } from './native.ts';
+import type { TClContext, TClProgram } from './native.ts';
+
+const {
+	createProgramWithSource,
+	buildProgram,
+	releaseProgram,
+} = native;
+
+export type TProgramCacheStats = Readonly<{
+	programs: number;
+	hits: number;
+	misses: number;
+}>;
+
+export type TProgramCache = {
+	/**
+	 * Get a program built from `source` with `options`, for all devices of `context`.
+	 *
+	 * The same source and options in the same context give the same program.
+	 * Every `acquire()` needs a matching `release()`.
+	*/
+	acquire: (context: TClContext, source: string, options?: string) => TClProgram;
+	/** The program is released when the last user releases it. */
+	release: (program: TClProgram) => void;
+	getStats: () => TProgramCacheStats;
+};
+
+type TEntry = {
+	key: string;
+	program: TClProgram;
+	refs: number;
+};
+
+/**
+ * Deduplicate identical program builds within the process.
+ *
+ * A cached program retains its context, so the context handle in a key
+ * can't be reused by another context while the entry lives.
+ */
+export const createProgramCache = (): TProgramCache => {
+	const byKey = new Map<string, TEntry>();
+	const byProgram = new Map<TClProgram, TEntry>();
+	let hits = 0;
+	let misses = 0;
+	
+	return {
+		acquire: (context, source, options = ''): TClProgram => {
+			const key = createHash('sha256')
+				.update(`${context._}\0${options}\0`)
+				.update(source)
+				.digest('hex');
+			
+			const cached = byKey.get(key);
+			if (cached) {
+				cached.refs++;
+				hits++;
+				return cached.program;
+			}
+			
+			misses++;
+			const program = createProgramWithSource(context, source);
+			try {
+				buildProgram(program, null, options);
+			} catch (error) {
+				releaseProgram(program);
+				throw error;
+			}
+			
+			const entry: TEntry = { key, program, refs: 1 };
+			byKey.set(key, entry);
+			byProgram.set(program, entry);
+			return program;
+		},
+		
+		release: (program): void => {
+			const entry = byProgram.get(program);
+			if (!entry) {
+				throw new Error('The program is not from this cache.');
+			}
+			if (--entry.refs > 0) {
+				return;
+			}
+			byKey.delete(entry.key);
+			byProgram.delete(program);
+			releaseProgram(program);
+		},
+		
+		getStats: (): TProgramCacheStats => ({ programs: byKey.size, hits, misses }),
+	};
+};
+
+/** The cache shared by all modules of the process. */
+export const programCache: TProgramCache = createProgramCache();
@@ -7,6 +7,8 @@ import * as U from './utils.ts';
 
 const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
 const squareCpyKern = fs.readFileSync(new URL('../examples/assets/kernels/square_cpy.cl', import.meta.url)).toString();
+// `kernel void square(global float *data)`, squares `data` in place
+const squareSpirv = fs.readFileSync(new URL('../examples/assets/kernels/square.spv', import.meta.url));
 
 
 describe('Program', () => {
@@ -77,6 +79,33 @@ describe('Program', () => {
 		});
 	});
 
+	describe('#buildProgramAsync', () => {
+		it('builds several programs in parallel', async () => {
+			const programs = [0, 1, 2, 3].map(() => cl.createProgramWithSource(context, squareKern));
+			await Promise.all(programs.map((prg, i) => cl.buildProgramAsync(prg, [device], `-D ID=${i}`)));
+			
+			for (const prg of programs) {
+				const kernel = cl.createKernel(prg, 'square');
+				cl.releaseKernel(kernel);
+				cl.releaseProgram(prg);
+			}
+		});
+		
+		it('rejects with the build logs', async () => {
+			const prg = cl.createProgramWithSource(context, '__kernel void broken() { nope; }');
+			await assert.rejects(
+				() => cl.buildProgramAsync(prg),
+				(error: cl.TClBuildError) => {
+					assert.strictEqual(error.code, cl.BUILD_PROGRAM_FAILURE);
+					assert.ok(error.logs.length > 0);
+					assert.ok(error.logs.some(({ log }) => log.length > 0));
+					return true;
+				},
+			);
+			cl.releaseProgram(prg);
+		});
+	});
+	
 	describe('#createProgramWithBinary', () => {
 		it('fails as binaries list is empty', () => {
 			assert.throws(
@@ -86,6 +115,52 @@ describe('Program', () => {
 		});
 	});
 	
+	describe('#createProgramWithIL', () => {
+		const getIlVersion = (): string => {
+			try {
+				return String(cl.getDeviceInfo(device, cl.DEVICE_IL_VERSION));
+			} catch {
+				return '';
+			}
+		};
+		const hasIl = getIlVersion().includes('SPIR-V');
+		
+		it('fails as IL is empty', () => {
+			assert.throws(() => cl.createProgramWithIL(context, new Uint8Array(0)));
+		});
+		
+		it('fails as IL is not SPIR-V', () => {
+			assert.throws(() => cl.createProgramWithIL(context, new Uint32Array([1, 2, 3, 4])));
+		});
+		
+		it('has no IL for a program from source', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				assert.strictEqual(cl.getProgramInfo(prg, cl.PROGRAM_IL), null);
+			});
+		});
+		
+		it('builds and runs a kernel from SPIR-V', { skip: !hasIl }, () => {
+			const prg = cl.createProgramWithIL(context, squareSpirv);
+			cl.buildProgram(prg);
+			const il = cl.getProgramInfo(prg, cl.PROGRAM_IL) as ArrayBuffer;
+			assert.strictEqual(il.byteLength, squareSpirv.byteLength);
+			
+			const queue = U.newQueue(context, device);
+			const kernel = cl.createKernel(prg, 'square');
+			const data = new Float32Array([1, 2, 3, 4]);
+			const mem = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, data);
+			cl.setKernelArg(kernel, 0, 'float*', mem);
+			cl.enqueueNDRangeKernel(queue, kernel, 1, null, [4]);
+			cl.enqueueReadBuffer(queue, mem, true, 0, 16, data);
+			assert.deepStrictEqual(Array.from(data), [1, 4, 9, 16]);
+			
+			cl.releaseMemObject(mem);
+			cl.releaseKernel(kernel);
+			cl.releaseCommandQueue(queue);
+			cl.releaseProgram(prg);
+		});
+	});
+	
 	describe('#createProgramWithBuiltInKernels', () => {
 		it('fails as context is invalid', () => {
 			assert.throws(
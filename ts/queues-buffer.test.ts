@@ -66,6 +66,25 @@ describe('CommandQueue - Buffer', () => {
 		});
 	});
 	
+	describe('#enqueueReadBufferAsync', () => {
+		it('resolves with the host buffer', async () => {
+			const buffer = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 8, Buffer.alloc(8).fill(7));
+			const nbuffer = Buffer.alloc(8);
+			const ret = await cl.enqueueReadBufferAsync(cq, buffer, 0, 8, nbuffer);
+			cl.releaseMemObject(buffer);
+			assert.strictEqual(ret, nbuffer);
+			assert.strictEqual(nbuffer[7], 7);
+		});
+		
+		it('fails if buffer is null', () => {
+			const nbuffer = Buffer.alloc(8);
+			assert.throws(
+				() => cl.enqueueReadBufferAsync(cq, null as unknown as cl.TClMem, 0, 8, nbuffer),
+				new Error('Argument 1 must be of type `Object`'),
+			);
+		});
+	});
+	
 	describe('#enqueueReadBufferRect', () => {
 		it('works with valid buffers', () => {
 			const buffer = cl.createBuffer(context, cl.MEM_READ_ONLY, 200, null);
@@ -133,6 +152,23 @@ describe('CommandQueue - Buffer', () => {
 			assert.strictEqual(ret, undefined);
 		});
 		
+		it('keeps the host memory of a non-blocking write alive', { skip: !globalThis.gc }, () => {
+			const size = 1 << 22;
+			const buffer = cl.createBuffer(context, cl.MEM_READ_WRITE, size, null);
+			const write = () => {
+				cl.enqueueWriteBuffer(cq, buffer, false, 0, size, new Uint8Array(size).fill(7));
+			};
+			write();
+			// The source array is only referenced by the pending write now
+			globalThis.gc?.();
+			cl.finish(cq);
+			
+			const out = new Uint8Array(size);
+			cl.enqueueReadBuffer(cq, buffer, true, 0, size, out);
+			assert.ok(out.every((x) => x === 7));
+			cl.releaseMemObject(buffer);
+		});
+		
 		it('fails if buffer is null', () => {
 			const nbuffer = Buffer.alloc(5);
 			assert.throws(
@@ -152,6 +188,67 @@ describe('CommandQueue - Buffer', () => {
 		});
 	});
 	
+	describe('#enqueueWriteBufferAsync', () => {
+		it('resolves after the write is complete', async () => {
+			const buffer = cl.createBuffer(context, cl.MEM_READ_WRITE, 8, null);
+			const ret = await cl.enqueueWriteBufferAsync(cq, buffer, 0, 8, Buffer.alloc(8).fill(5));
+			assert.strictEqual(ret, undefined);
+			
+			const nbuffer = Buffer.alloc(8);
+			cl.enqueueReadBuffer(cq, buffer, true, 0, 8, nbuffer);
+			cl.releaseMemObject(buffer);
+			assert.strictEqual(nbuffer[0], 5);
+		});
+	});
+	
+	describe('#acquireStagingBuffer', () => {
+		it('transfers through a pooled pinned buffer', () => {
+			const buffer = cl.createBuffer(context, cl.MEM_READ_WRITE, 16, null);
+			
+			const upload = cl.acquireStagingBuffer(cq, 16);
+			assert.strictEqual(upload.byteLength, 16);
+			new Float32Array(upload).set([1, 2, 3, 4]);
+			cl.enqueueWriteBuffer(cq, buffer, true, 0, 16, upload);
+			cl.releaseStagingBuffer(upload);
+			assert.strictEqual(upload.byteLength, 0);
+			
+			const download = cl.acquireStagingBuffer(cq, 16);
+			cl.enqueueReadBuffer(cq, buffer, true, 0, 16, download);
+			assert.deepStrictEqual(Array.from(new Float32Array(download)), [1, 2, 3, 4]);
+			cl.releaseStagingBuffer(download);
+			
+			cl.releaseMemObject(buffer);
+			assert.ok(cl.trimStagingBuffers() >= 16);
+		});
+		
+		it('reuses a released buffer only after its transfers', async () => {
+			cl.trimStagingBuffers();
+			const userEvent = cl.createUserEvent(context);
+			const staging = cl.acquireStagingBuffer(cq, 1 << 16);
+			cl.releaseStagingBuffer(staging, [userEvent]);
+			assert.strictEqual(staging.byteLength, 0);
+			assert.strictEqual(cl.trimStagingBuffers(), 0);
+			
+			cl.setUserEventStatus(userEvent, cl.COMPLETE);
+			cl.finish(cq);
+			// The slot is returned from a CL callback, maybe a bit after the queue is done
+			let freed = 0;
+			for (let i = 0; i < 100 && !freed; i++) {
+				await new Promise((resolve) => setTimeout(resolve, 10));
+				freed = cl.trimStagingBuffers();
+			}
+			assert.strictEqual(freed, 1 << 16);
+			cl.releaseEvent(userEvent);
+		});
+		
+		it('fails to release a foreign ArrayBuffer', () => {
+			assert.throws(
+				() => cl.releaseStagingBuffer(new ArrayBuffer(16)),
+				new Error('Argument 0 must be a staging ArrayBuffer.'),
+			);
+		});
+	});
+	
 	describe('#enqueueWriteBufferRect', () => {
 		it('works with valid buffers', () => {
 			const buffer = cl.createBuffer(context, cl.MEM_READ_ONLY, 200, null);
@@ -483,4 +580,53 @@ describe('CommandQueue - Buffer', () => {
 			);
 		});
 	});
+	
+	describe('#enqueueMapBufferAsync', () => {
+		it('resolves with the mapped data', async () => {
+			const buf = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 8, Buffer.alloc(8).fill(3));
+			const ret = await cl.enqueueMapBufferAsync(cq, buf, cl.MAP_READ, 0, 8);
+			assert.ok(ret.buffer instanceof ArrayBuffer);
+			assert.strictEqual(new Uint8Array(ret.buffer)[0], 3);
+			cl.enqueueUnmapMemObject(cq, buf, ret.buffer);
+			cl.finish(cq);
+			cl.releaseMemObject(buf);
+		});
+	});
+	
+	describe('Mapping', () => {
+		it('maps a buffer region', () => {
+			const buf = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 8, Buffer.alloc(8).fill(3));
+			const mapping = new cl.Mapping(cq, buf, cl.MAP_READ | cl.MAP_WRITE, 0, 8);
+			assert.ok(mapping.isMapped);
+			assert.strictEqual(new Uint8Array(mapping.buffer as ArrayBuffer)[0], 3);
+			mapping.unmap();
+			cl.finish(cq);
+			cl.releaseMemObject(buf);
+		});
+		
+		it('detaches the memory on unmap', () => {
+			const buf = cl.createBuffer(context, cl.MEM_READ_WRITE, 8, null);
+			const mapping = new cl.Mapping(cq, buf, cl.MAP_WRITE, 0, 8);
+			const view = new Uint8Array(mapping.buffer as ArrayBuffer);
+			mapping.unmap();
+			assert.strictEqual(view.length, 0);
+			assert.strictEqual(mapping.buffer, null);
+			assert.ok(!mapping.isMapped);
+			cl.finish(cq);
+			cl.releaseMemObject(buf);
+		});
+		
+		it('unmaps on dispose', () => {
+			const buf = cl.createBuffer(context, cl.MEM_READ_WRITE, 8, null);
+			const mapping = new cl.Mapping(cq, buf, cl.MAP_WRITE, 0, 8);
+			new Uint8Array(mapping.buffer as ArrayBuffer).fill(5);
+			mapping[Symbol.dispose]();
+			assert.ok(!mapping.isMapped);
+			
+			const out = Buffer.alloc(8);
+			cl.enqueueReadBuffer(cq, buf, true, 0, 8, out);
+			assert.strictEqual(out[0], 5);
+			cl.releaseMemObject(buf);
+		});
+	});
 });
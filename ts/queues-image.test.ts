@@ -50,6 +50,25 @@ describe('CommandQueue - Image', () => {
 			assert.strictEqual(ret, undefined);
 		});
 		
+		it('ignores the coords past the 3rd', () => {
+			const ret = cl.enqueueReadImage(
+				cq,
+				image,
+				true,
+				[0, 0, 0, 7, 7],
+				[8, 8, 1, 9, 9],
+				0,
+				0,
+				Buffer.alloc(64 * 4),
+			);
+			assert.strictEqual(ret, undefined);
+		});
+		
+		it('reads a short origin as zeros', async () => {
+			const host = await cl.enqueueReadImageAsync(cq, image, [0], validRegion, 0, 0, Buffer.alloc(64 * 4));
+			assert.strictEqual(host.byteLength, 64 * 4);
+		});
+		
 		it('fails with bad parameters', () => {
 			assert.throws(
 				() => cl.enqueueReadImage(
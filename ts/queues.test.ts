@@ -83,6 +83,20 @@ describe('CommandQueue - Common', () => {
 		});
 	});
 	
+	describe('#finishAsync', () => {
+		it('resolves when the queue is drained', async () => {
+			const buffer = cl.createBuffer(context, cl.MEM_READ_WRITE, 8, null);
+			const event = cl.enqueueWriteBuffer(
+				cq, buffer, false, 0, 8, Buffer.alloc(8), null, true,
+			) as cl.TClEvent;
+			await cl.finishAsync(cq);
+			const status = cl.getEventInfo(event, cl.EVENT_COMMAND_EXECUTION_STATUS);
+			assert.strictEqual(status, cl.COMPLETE);
+			cl.releaseEvent(event);
+			cl.releaseMemObject(buffer);
+		});
+	});
+	
 	describe('#enqueueUnmapMemObject', () => {
 		it('throws as we are unmapping a non mapped memobject', () => {
 			const buf = cl.createBuffer(context, 0, 8, null);
@@ -181,6 +195,152 @@ describe('CommandQueue - Common', () => {
 		});
 	});
 	
+	describe('#dispatch', () => {
+		it('binds args and runs the kernel', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				const input = new Float32Array([1, 2, 3, 4]);
+				const output = new Float32Array(4);
+				
+				const inputMem = cl.createBuffer(context, cl.MEM_COPY_HOST_PTR, 16, input);
+				const outputMem = cl.createBuffer(context, cl.MEM_WRITE_ONLY, 16, null);
+				
+				const event = cl.dispatch(
+					cq, kern, [inputMem, outputMem, 4], 4, null, null, true,
+				) as cl.TClEvent;
+				U.assertType(event, 'object');
+				
+				cl.enqueueReadBuffer(cq, outputMem, true, 0, 16, output, [event]);
+				assert.deepStrictEqual(Array.from(output), [1, 4, 9, 16]);
+				
+				cl.releaseEvent(event);
+				cl.releaseMemObject(inputMem);
+				cl.releaseMemObject(outputMem);
+				cl.releaseKernel(kern);
+			});
+		});
+		
+		it('fails if local size does not match global', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				assert.throws(
+					() => cl.dispatch(cq, kern, null, [4], [1, 1]),
+					cl.INVALID_WORK_GROUP_SIZE,
+				);
+				cl.releaseKernel(kern);
+			});
+		});
+		
+		it('fails for negative work sizes', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				assert.throws(
+					() => cl.dispatch(cq, kern, null, [4, -1]),
+					cl.INVALID_GLOBAL_WORK_SIZE,
+				);
+				cl.releaseKernel(kern);
+			});
+		});
+		
+		it('reports the index of an invalid argument', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				assert.throws(
+					() => cl.dispatch(cq, kern, [null], [4]),
+					new Error('Array item #0 must be of type `Object`'),
+				);
+				cl.releaseKernel(kern);
+			});
+		});
+	});
+	
+	describe('CommandList', () => {
+		it('replays the recorded commands', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				const input = new Float32Array([1, 2, 3, 4]);
+				const output = new Float32Array(4);
+				
+				const inputMem = cl.createBuffer(context, cl.MEM_READ_ONLY, 16, null);
+				const outputMem = cl.createBuffer(context, cl.MEM_WRITE_ONLY, 16, null);
+				
+				const list = new cl.CommandList();
+				const write = list.write(inputMem, 0, 16, input);
+				const run = list.ndrange(kern, [inputMem, outputMem, 4], 4, null, [write]);
+				list.read(outputMem, 0, 16, output, [run]);
+				assert.strictEqual(list.length, 3);
+				
+				for (let i = 0; i < 2; i++) {
+					output.fill(0);
+					const event = list.run(cq, null, true) as cl.TClEvent;
+					cl.waitForEvents([event]);
+					cl.releaseEvent(event);
+					assert.deepStrictEqual(Array.from(output), [1, 4, 9, 16]);
+				}
+				
+				list.clear();
+				assert.strictEqual(list.length, 0);
+				
+				cl.releaseMemObject(inputMem);
+				cl.releaseMemObject(outputMem);
+				cl.releaseKernel(kern);
+			});
+		});
+		
+		it('keeps the objects of a run in flight after clear', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				const output = new Float32Array(4);
+				const inputMem = cl.createBuffer(context, cl.MEM_READ_ONLY, 16, null);
+				const outputMem = cl.createBuffer(context, cl.MEM_WRITE_ONLY, 16, null);
+				
+				const list = new cl.CommandList();
+				const write = list.write(inputMem, 0, 16, new Float32Array([1, 2, 3, 4]));
+				const run = list.ndrange(kern, [inputMem, outputMem, 4], 4, null, [write]);
+				list.read(outputMem, 0, 16, output, [run]);
+				
+				list.run(cq);
+				list.clear();
+				cl.releaseMemObject(inputMem);
+				cl.releaseMemObject(outputMem);
+				cl.releaseKernel(kern);
+				
+				cl.finish(cq);
+				assert.deepStrictEqual(Array.from(output), [1, 4, 9, 16]);
+			});
+		});
+		
+		it('records nothing of a failed command', () => {
+			U.withProgram(context, squareKern, (prg) => {
+				const kern = cl.createKernel(prg, 'square');
+				const mem = cl.createBuffer(context, cl.MEM_READ_WRITE, 16, null);
+				
+				const list = new cl.CommandList();
+				const write = list.write(mem, 0, 16, new Float32Array(4));
+				const count = cl.getMemObjectInfo(mem, cl.MEM_REFERENCE_COUNT);
+				
+				assert.throws(() => list.ndrange(kern, [mem, mem, 'a'], 4, null, [write]));
+				assert.throws(() => list.read(mem, 0, 16, new Float32Array(1), [write]));
+				assert.strictEqual(list.length, 1);
+				assert.strictEqual(cl.getMemObjectInfo(mem, cl.MEM_REFERENCE_COUNT), count);
+				
+				list.run(cq);
+				cl.finish(cq);
+				list.clear();
+				cl.releaseMemObject(mem);
+				cl.releaseKernel(kern);
+			});
+		});
+		
+		it('fails given an unknown dependency', () => {
+			const list = new cl.CommandList();
+			assert.throws(
+				() => list.barrier([0]),
+				new Error('Array item #0 is not a recorded command index.'),
+			);
+		});
+	});
+	
 	describe('#enqueueTask', () => {
 		it('works with a valid call', () => {
 			U.withProgram(context, squareOneKern, (prg) => {
@@ -0,0 +1,68 @@
+import fs from 'node:fs';
+import { strict as assert } from 'node:assert';
+import { describe, it, after } from 'node:test';
+import * as cl from './index.ts';
+import * as U from './utils.ts';
+
+const squareKern = fs.readFileSync(new URL('../examples/assets/kernels/square.cl', import.meta.url)).toString();
+
+
+describe('Stream', () => {
+	const { context, device } = cl.quickStart();
+	const queues = [U.newQueue(context, device), U.newQueue(context, device)];
+	const program = cl.createProgramWithSource(context, squareKern);
+	cl.buildProgram(program);
+	const kernel = cl.createKernel(program, 'square');
+	
+	after(() => {
+		cl.releaseKernel(kernel);
+		cl.releaseProgram(program);
+		queues.forEach((queue) => cl.releaseCommandQueue(queue));
+	});
+	
+	const getOptions = (chunkSize: number): cl.TStreamOptions => ({
+		context,
+		queues,
+		kernel,
+		chunkSize,
+		getArgs: (input, output, size) => [input, output, size / 4],
+		getWorkSize: (size) => size / 4,
+	});
+	
+	describe('#streamCompute', () => {
+		it('processes all chunks in order', async () => {
+			const source = Float32Array.from({ length: 1000 }, (_v, i) => i);
+			const results: Float32Array[] = [];
+			let expectedIndex = 0;
+			
+			for await (const chunk of cl.streamCompute(source, getOptions(256 * 4))) {
+				assert.strictEqual(chunk.index, expectedIndex++);
+				assert.strictEqual(chunk.offset, chunk.index * 256 * 4);
+				results.push(new Float32Array(chunk.data.buffer));
+			}
+			
+			assert.strictEqual(results.length, 4);
+			assert.strictEqual(results[3].length, 1000 - 3 * 256);
+			assert.strictEqual(results[1][0], 256 * 256);
+			assert.strictEqual(results[3][1000 - 3 * 256 - 1], 999 * 999);
+		});
+		
+		it('stops early on break', async () => {
+			const source = new Float32Array(4096);
+			let count = 0;
+			for await (const _chunk of cl.streamCompute(source, getOptions(1024))) {
+				count++;
+				break;
+			}
+			assert.strictEqual(count, 1);
+		});
+		
+		it('throws without queues', async () => {
+			const options = { ...getOptions(1024), queues: [] };
+			await assert.rejects(
+				() => cl.streamCompute(new Float32Array(16), options).next(),
+				new Error('At least one queue is required.'),
+			);
+		});
+	});
+});
@@ -0,0 +1,125 @@
+import { native } from './native.ts';
+import type { TClContext, TClHostData, TClKernel, TClMem, TClQueue } from './native.ts';
+
+const {
+	createBuffer,
+	releaseMemObject,
+	enqueueWriteBuffer,
+	enqueueReadBufferAsync,
+	dispatch,
+	MEM_READ_ONLY,
+	MEM_WRITE_ONLY,
+} = native;
+
+export type TStreamOptions = Readonly<{
+	context: TClContext;
+	/**
+	 * In-order queues to spread the chunks over. With 2 or more, the upload of
+	 * a chunk overlaps the kernel of the previous one.
+	*/
+	queues: readonly TClQueue[];
+	kernel: TClKernel;
+	/** Input bytes per chunk, the last chunk may be shorter. */
+	chunkSize: number;
+	/** Chunks in flight, each with a device buffer pair. 2 by default. */
+	depth?: number;
+	/** Output bytes for an input chunk of `size` bytes. The same size by default. */
+	getOutputSize?: (size: number) => number;
+	/** Kernel args for a chunk, `size` is the input chunk size. */
+	getArgs: (input: TClMem, output: TClMem, size: number, index: number) => readonly unknown[];
+	getWorkSize: (size: number) => number | number[];
+	workLocal?: number | number[] | null;
+}>;
+
+export type TStreamChunk = Readonly<{
+	index: number;
+	/** Offset of the input chunk within the source. */
+	offset: number;
+	data: Uint8Array;
+}>;
+
+type TStreamSlot = Readonly<{
+	queue: TClQueue;
+	input: TClMem;
+	output: TClMem;
+}>;
+
+const toBytes = (source: TClHostData): Uint8Array => (
+	ArrayBuffer.isView(source)
+		? new Uint8Array(source.buffer, source.byteOffset, source.byteLength)
+		: new Uint8Array(source)
+);
+
+/**
+ * Upload, process and download a large host source chunk by chunk.
+ *
+ * Up to `depth` chunks are in flight: chunk N+1 is uploaded while the kernel
+ * runs on chunk N, and chunk N-1 is read back. The results come in order.
+ * Breaking out of the loop waits for the chunks in flight, then frees the buffers.
+ */
+export async function* streamCompute(
+	source: TClHostData,
+	options: TStreamOptions,
+): AsyncGenerator<TStreamChunk, void, undefined> {
+	const {
+		context, queues, kernel, chunkSize, depth = 2,
+		getOutputSize = (size: number): number => size,
+		getArgs, getWorkSize, workLocal = null,
+	} = options;
+	
+	if (!queues.length) {
+		throw new Error('At least one queue is required.');
+	}
+	if (!(chunkSize > 0)) {
+		throw new RangeError('The chunk size must be positive.');
+	}
+	
+	const bytes = toBytes(source);
+	const count = Math.ceil(bytes.byteLength / chunkSize);
+	const outputCapacity = getOutputSize(chunkSize);
+	
+	const slots: TStreamSlot[] = [];
+	const pending: Promise<TStreamChunk>[] = [];
+	
+	// The chunk that used this slot before has been read back already
+	const enqueueChunk = (index: number): Promise<TStreamChunk> => {
+		const slot = slots[index % slots.length];
+		const offset = index * chunkSize;
+		const size = Math.min(chunkSize, bytes.byteLength - offset);
+		
+		enqueueWriteBuffer(slot.queue, slot.input, false, 0, size, bytes.subarray(offset, offset + size));
+		dispatch(
+			slot.queue, kernel, getArgs(slot.input, slot.output, size, index), getWorkSize(size), workLocal,
+		);
+		
+		const data = new Uint8Array(getOutputSize(size));
+		return enqueueReadBufferAsync(slot.queue, slot.output, 0, data.byteLength, data).then(
+			(): TStreamChunk => ({ index, offset, data }),
+		);
+	};
+	
+	try {
+		for (let i = 0; i < Math.min(Math.max(1, depth), count); i++) {
+			slots.push({
+				queue: queues[i % queues.length],
+				input: createBuffer(context, MEM_READ_ONLY, chunkSize, null),
+				output: createBuffer(context, MEM_WRITE_ONLY, outputCapacity, null),
+			});
+		}
+		
+		let next = 0;
+		while (next < count || pending.length) {
+			while (next < count && pending.length < slots.length) {
+				pending.push(enqueueChunk(next++));
+			}
+			const chunk = pending.shift() as Promise<TStreamChunk>;
+			yield await chunk;
+		}
+	} finally {
+		await Promise.allSettled(pending);
+		for (const slot of slots) {
+			releaseMemObject(slot.input);
+			releaseMemObject(slot.output);
+		}
+	}
+}